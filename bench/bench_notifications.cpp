@@ -0,0 +1,235 @@
+// Bildirim gönderim benchmark'ı: yerel bir HTTP sunucusuna karşı
+// HttpDispatcher eşzamanlılığı ve NotificationSystem uçtan uca (tekli/toplu webhook)
+#include "HttpDispatcher.hpp"
+#include "NotificationSystem.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Keep-alive destekli minimal HTTP/1.1 sunucusu; her isteğe 200 döner
+class LocalHttpServer {
+public:
+    explicit LocalHttpServer(int responseDelayMicros)
+        : delayMicros(responseDelayMicros), running(true),
+          requests(0), events(0), connections(0) {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listenFd, 64);
+
+        socklen_t length = sizeof(addr);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &length);
+        port = ntohs(addr.sin_port);
+
+        acceptor = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~LocalHttpServer() {
+        running = false;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptor.join();
+        for (auto& worker : workers) worker.join();
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port) + "/hook";
+    }
+
+    uint64_t requestCount() const { return requests; }
+    uint64_t eventCount() const { return events; }
+    uint64_t connectionCount() const { return connections; }
+
+private:
+    int listenFd;
+    int port;
+    int delayMicros;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> requests;
+    std::atomic<uint64_t> events;
+    std::atomic<uint64_t> connections;
+    std::thread acceptor;
+    std::vector<std::thread> workers;
+
+    void acceptLoop() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) break;
+            connections++;
+            workers.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        static const char RESPONSE[] =
+            "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n";
+        std::string buffer;
+        char chunk[16384];
+
+        while (running) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) { close(fd); return; }
+                buffer.append(chunk, n);
+            }
+
+            size_t contentLength = 0;
+            size_t field = buffer.find("Content-Length:");
+            if (field != std::string::npos && field < headerEnd) {
+                contentLength = std::stoul(buffer.substr(field + 15));
+            }
+
+            size_t total = headerEnd + 4 + contentLength;
+            while (buffer.size() < total) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) { close(fd); return; }
+                buffer.append(chunk, n);
+            }
+
+            // Toplu gövdede her olay bir "message" alanı taşır
+            std::string body = buffer.substr(headerEnd + 4, contentLength);
+            for (size_t pos = 0; (pos = body.find("\"message\":", pos)) != std::string::npos; pos++) {
+                events++;
+            }
+            buffer.erase(0, total);
+
+            if (delayMicros > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(delayMicros));
+            }
+            send(fd, RESPONSE, sizeof(RESPONSE) - 1, MSG_NOSIGNAL);
+            requests++;
+        }
+        close(fd);
+    }
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    return values[index];
+}
+
+void benchDispatcher(int requestCount, int delayMicros) {
+    std::cout << "HttpDispatcher: " << requestCount << " POST, sunucu gecikmesi "
+              << delayMicros << " us\n"
+              << std::setw(12) << "eşzamanlı"
+              << std::setw(14) << "istek/sn"
+              << std::setw(14) << "p50 (ms)"
+              << std::setw(14) << "p99 (ms)"
+              << std::setw(14) << "bağlantı" << "\n";
+
+    for (int inFlight : {1, 4, 8, 16}) {
+        LocalHttpServer server(delayMicros);
+        HttpDispatcher http(inFlight);
+        std::vector<double> latencies;
+        latencies.reserve(requestCount);
+        http.setCompletionCallback([&latencies](const HttpDispatcher::Result& result) {
+            latencies.push_back(result.seconds * 1000.0);
+        });
+
+        // Gönderim turları gibi: 32'lik gruplar
+        auto start = std::chrono::steady_clock::now();
+        for (int sent = 0; sent < requestCount;) {
+            for (int k = 0; k < 32 && sent < requestCount; k++, sent++) {
+                http.post(server.url(), "{\"message\":\"event " + std::to_string(sent) + "\"}",
+                          HttpDispatcher::ContentType::JSON);
+            }
+            http.runUntilIdle();
+        }
+        double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        // Tur başına gecikme kuyruk bekleme süresini de içerir
+        std::cout << std::setw(12) << inFlight
+                  << std::setw(14) << std::fixed << std::setprecision(0) << requestCount / seconds
+                  << std::setw(14) << std::setprecision(2) << percentile(latencies, 0.50)
+                  << std::setw(14) << percentile(latencies, 0.99)
+                  << std::setw(14) << server.connectionCount() << "\n";
+    }
+    std::cout << "\n";
+}
+
+void benchNotificationSystem(int eventCount, int delayMicros) {
+    std::cout << "NotificationSystem: " << eventCount << " olay (öncelik 1, yalnızca webhook)\n"
+              << std::setw(10) << "mod"
+              << std::setw(18) << "enqueue (us)"
+              << std::setw(16) << "olay/sn"
+              << std::setw(12) << "istek"
+              << std::setw(12) << "ulaşan"
+              << std::setw(12) << "düşen" << "\n";
+
+    for (bool batched : {false, true}) {
+        LocalHttpServer server(delayMicros);
+        double enqueueMicros = 0.0;
+        double seconds = 0.0;
+        uint64_t dropped = 0;
+        {
+            NotificationSystem notifications;
+            notifications.initialize("", server.url(), "");
+            notifications.setWebhookBatching(batched, 50);
+
+            // Benchmark olayları birbirinden farklı; birleştirme devre dışı
+            AlertCoalescer::Policy policy;
+            policy.suppressionWindow = 0.0;
+            policy.ratePerMinute = 1e9;
+            policy.burst = 1e9;
+            notifications.setCoalescingPolicy(policy);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < eventCount; i++) {
+                notifications.sendNotification({
+                    NotificationSystem::NotificationType::MOTION_DETECTED,
+                    "Benchmark event \"" + std::to_string(i) + "\"\n",
+                    "2024-01-01 00:00:00",
+                    1,
+                    ""  // imageUrl
+                });
+            }
+            auto enqueued = std::chrono::steady_clock::now();
+            enqueueMicros = std::chrono::duration<double, std::micro>(enqueued - start).count() / eventCount;
+
+            notifications.shutdown(true);
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            dropped = notifications.getDroppedCount();
+        }
+
+        std::cout << std::setw(10) << (batched ? "toplu" : "tekli")
+                  << std::setw(18) << std::fixed << std::setprecision(2) << enqueueMicros
+                  << std::setw(16) << std::setprecision(0) << eventCount / seconds
+                  << std::setw(12) << server.requestCount()
+                  << std::setw(12) << server.eventCount()
+                  << std::setw(12) << dropped << "\n";
+    }
+}
+
+}
+
+int main() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    benchDispatcher(2000, 2000);
+    benchNotificationSystem(250, 2000);
+
+    curl_global_cleanup();
+    return 0;
+}
\ No newline at end of file
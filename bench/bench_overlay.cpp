@@ -0,0 +1,148 @@
+// Ekran çizimi benchmark'ı: drawDetections'ın tespit başına maliyeti.
+// Önceki yol (stringstream + getline + getTextSize/putText her satır) ile
+// LabelCache sprite'larıyla çizim 1080p karede 10/50/200 tespitte karşılaştırılır.
+#include "FastyDetector.hpp"
+#include "LabelCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+const int SCENE_WIDTH = 1920;
+const int SCENE_HEIGHT = 1080;
+const int FRAMES = 200;
+
+const char* CLASS_NAMES[] = {"person", "boat", "bird", "surfboard"};
+
+std::vector<Detection> makeDetections(int count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> x(0, SCENE_WIDTH - 120);
+    std::uniform_int_distribution<int> y(100, SCENE_HEIGHT - 80);
+    std::uniform_real_distribution<float> distance(5.0f, 60.0f);
+
+    std::vector<Detection> detections(count);
+    for (int i = 0; i < count; i++) {
+        Detection& det = detections[i];
+        det.classId = i % 4;
+        det.className = CLASS_NAMES[det.classId];
+        det.bbox = cv::Rect(x(rng), y(rng), 80, 60);
+        det.confidence = 0.9f;
+        det.distance = distance(rng);
+        det.isMoving = (i % 2) == 0;
+        det.velocity = 1.5f;
+        det.direction = cv::Point2f(1, 0);
+        det.calculateCenter();
+    }
+    return detections;
+}
+
+// Kareler arası küçük değişim: mesafe ve güven titrer, konum kayar
+void stepDetections(std::vector<Detection>& detections, std::mt19937& rng) {
+    std::normal_distribution<float> jitter(0.0f, 0.05f);
+    for (auto& det : detections) {
+        det.distance = std::max(0.0f, det.distance + jitter(rng));
+        det.confidence = std::min(1.0f, std::max(0.0f, det.confidence + jitter(rng) * 0.1f));
+        det.bbox.x = (det.bbox.x + 1) % (SCENE_WIDTH - 120);
+        det.calculateCenter();
+    }
+}
+
+// Önceki drawDetections etiket yolu (karşılaştırma için)
+void drawLabelsUncached(cv::Mat& frame, const std::vector<Detection>& detections) {
+    for (const auto& det : detections) {
+        cv::Scalar color(200, 120, 40);
+        cv::rectangle(frame, det.bbox, color, 2);
+
+        std::stringstream ss;
+        ss << det.className << " ("
+           << std::fixed << std::setprecision(1)
+           << det.confidence * 100 << "%)";
+        ss << "\nMesafe: " << std::fixed << std::setprecision(1) << det.distance << "m";
+        if (det.isMoving) {
+            ss << "\nHiz: " << std::fixed << std::setprecision(1) << det.velocity << " m/s";
+        }
+
+        std::vector<std::string> lines;
+        std::string line;
+        std::istringstream text(ss.str());
+        while (std::getline(text, line)) {
+            lines.push_back(line);
+        }
+
+        int baseLine;
+        int maxWidth = 0;
+        for (const auto& l : lines) {
+            cv::Size textSize = cv::getTextSize(l, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseLine);
+            maxWidth = std::max(maxWidth, textSize.width);
+        }
+
+        int totalHeight = (lines.size() * (baseLine + 25));
+        cv::rectangle(frame,
+                     cv::Point(det.bbox.x, det.bbox.y - totalHeight - 10),
+                     cv::Point(det.bbox.x + maxWidth + 10, det.bbox.y),
+                     color, cv::FILLED);
+
+        int y = det.bbox.y - totalHeight + 20;
+        for (const auto& l : lines) {
+            cv::putText(frame, l, cv::Point(det.bbox.x + 5, y),
+                       cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(255, 255, 255), 1);
+            y += 25;
+        }
+        cv::circle(frame, det.center, 3, color, cv::FILLED);
+    }
+}
+
+template <typename Draw>
+double microsPerDetection(int count, Draw draw) {
+    std::mt19937 rng(42);
+    auto detections = makeDetections(count, rng);
+    cv::Mat background(SCENE_HEIGHT, SCENE_WIDTH, CV_8UC3, cv::Scalar(90, 70, 40));
+    cv::Mat frame;
+
+    double micros = 0.0;
+    for (int i = 0; i < FRAMES; i++) {
+        background.copyTo(frame);
+        stepDetections(detections, rng);
+        auto start = std::chrono::steady_clock::now();
+        draw(frame, detections);
+        micros += std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    return micros / (FRAMES * count);
+}
+
+}
+
+int main() {
+    FastyDetector detector;
+
+    std::cout << "drawDetections: 1920x1080, " << FRAMES << " kare\n"
+              << std::setw(10) << "tespit"
+              << std::setw(18) << "eski (us/tesp)"
+              << std::setw(20) << "önbellek (us/tesp)"
+              << std::setw(12) << "isabet %"
+              << std::setw(12) << "sprite" << "\n";
+
+    for (int count : {10, 50, 200}) {
+        double uncached = microsPerDetection(count, drawLabelsUncached);
+        auto before = detector.getLabelCacheStats();
+        double cached = microsPerDetection(count, [&detector](cv::Mat& frame,
+                                                              const std::vector<Detection>& dets) {
+            detector.drawDetections(frame, dets);
+        });
+        auto after = detector.getLabelCacheStats();
+
+        uint64_t hits = after.hits - before.hits;
+        uint64_t lookups = hits + (after.misses - before.misses);
+        std::cout << std::setw(10) << count
+                  << std::setw(18) << std::fixed << std::setprecision(2) << uncached
+                  << std::setw(20) << cached
+                  << std::setw(12) << std::setprecision(1) << (lookups ? 100.0 * hits / lookups : 0.0)
+                  << std::setw(12) << after.entries << "\n";
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+// İzleme benchmark'ı: 10, 100 ve 1000 nesnede saniyede işlenen iz sayısı
+#include "TrackingSystem.hpp"
+#include "TrackAssociation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int SCENE_WIDTH = 1920;
+const int SCENE_HEIGHT = 1080;
+
+struct SyntheticObject {
+    cv::Point2f position;
+    cv::Point2f velocity;
+    cv::Size size;
+};
+
+std::vector<SyntheticObject> makeScene(int count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> x(0.0f, SCENE_WIDTH);
+    std::uniform_real_distribution<float> y(0.0f, SCENE_HEIGHT);
+    std::uniform_real_distribution<float> v(-3.0f, 3.0f);
+    std::uniform_int_distribution<int> s(24, 64);
+
+    std::vector<SyntheticObject> objects(count);
+    for (auto& obj : objects) {
+        obj.position = cv::Point2f(x(rng), y(rng));
+        obj.velocity = cv::Point2f(v(rng), v(rng));
+        obj.size = cv::Size(s(rng), s(rng));
+    }
+    return objects;
+}
+
+std::vector<Detection> stepScene(std::vector<SyntheticObject>& objects, std::mt19937& rng) {
+    std::normal_distribution<float> jitter(0.0f, 1.0f);
+    std::vector<Detection> detections;
+    detections.reserve(objects.size());
+
+    for (auto& obj : objects) {
+        obj.position += obj.velocity;
+        if (obj.position.x < 0 || obj.position.x > SCENE_WIDTH) obj.velocity.x = -obj.velocity.x;
+        if (obj.position.y < 0 || obj.position.y > SCENE_HEIGHT) obj.velocity.y = -obj.velocity.y;
+
+        Detection det;
+        det.bbox = cv::Rect(static_cast<int>(obj.position.x + jitter(rng)),
+                            static_cast<int>(obj.position.y + jitter(rng)),
+                            obj.size.width, obj.size.height);
+        det.classId = 8;
+        det.className = "boat";
+        det.confidence = 0.9f;
+        det.calculateCenter();
+        detections.push_back(det);
+    }
+
+    // Tespit sırası her karede değişir (dedektör çıktısı gibi)
+    std::shuffle(detections.begin(), detections.end(), rng);
+    return detections;
+}
+
+struct Result {
+    double tracksPerSecond;
+    double associateMicros;
+};
+
+Result runBenchmark(int objectCount, int frames) {
+    std::mt19937 rng(42);
+    auto objects = makeScene(objectCount, rng);
+    TrackingSystem tracker;
+    cv::Mat frame;
+
+    const double frameInterval = 1.0 / 30.0;
+
+    // Isınma: izler oluşturulsun
+    auto warmup = stepScene(objects, rng);
+    tracker.updateTracks(warmup, frame, MediaTime(0));
+
+    std::vector<std::vector<Detection>> sequence;
+    sequence.reserve(frames);
+    for (int i = 0; i < frames; i++) {
+        sequence.push_back(stepScene(objects, rng));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        tracker.updateTracks(sequence[i], frame, MediaTime((i + 1) * frameInterval));
+    }
+    double trackerSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Yalnızca eşleştirme aşaması
+    std::vector<cv::Rect> previous, current;
+    for (const auto& det : warmup) previous.push_back(det.bbox);
+    double associateSeconds = 0.0;
+    for (const auto& detections : sequence) {
+        current.clear();
+        for (const auto& det : detections) current.push_back(det.bbox);
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto assignment = TrackAssociation::associate(previous, current, 0.3f);
+        associateSeconds += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+
+        (void)assignment;
+        previous.swap(current);
+    }
+
+    return {
+        static_cast<double>(objectCount) * frames / trackerSeconds,
+        associateSeconds / frames * 1e6
+    };
+}
+
+}
+
+int main() {
+    std::cout << "TrackingSystem::updateTracks benchmark\n\n"
+              << std::setw(10) << "nesne"
+              << std::setw(18) << "iz/saniye"
+              << std::setw(22) << "eşleştirme (us/kare)" << "\n";
+
+    for (int count : {10, 100, 1000}) {
+        int frames = count >= 1000 ? 300 : 3000;
+        Result result = runBenchmark(count, frames);
+        std::cout << std::setw(10) << count
+                  << std::setw(18) << std::fixed << std::setprecision(0) << result.tracksPerSecond
+                  << std::setw(22) << std::setprecision(1) << result.associateMicros << "\n";
+    }
+    return 0;
+}
\ No newline at end of file
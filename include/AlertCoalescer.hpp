@@ -0,0 +1,68 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bildirim birleştirme: aynı olayın (tip + anahtar) tekrarları bastırma
+// penceresi içinde düşürülür ve sayılır; her tip için token bucket toplam
+// hızı sınırlar. Bastırılan olaylar periyodik "N olay daha" özetine dönüşür.
+// İş parçacığı güvenli değildir; çağıran kilitler.
+class AlertCoalescer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Policy {
+        double suppressionWindow = 30.0;  // Aynı anahtar için tekrar aralığı (saniye)
+        double summaryInterval = 60.0;    // Özet gönderim aralığı (saniye)
+        double ratePerMinute = 20.0;      // Tip başına ortalama hız
+        double burst = 5.0;               // Tip başına anlık izin
+        int bypassPriority = 5;           // Bu öncelik ve üstü hız sınırına takılmaz
+    };
+
+    struct Event {
+        int type = 0;
+        std::string key;
+        std::string message;
+        std::string timestamp;
+        int priority = 0;
+    };
+
+    AlertCoalescer();
+
+    void setPolicy(const Policy& policy);
+    const Policy& getPolicy() const { return policy; }
+
+    // true: olay iletilmeli, false: bastırıldı (özete eklendi)
+    bool admit(const Event& event, Clock::time_point now);
+    // Süresi dolan özetler (force: bekleyen tüm özetler, kapanışta)
+    void collectSummaries(Clock::time_point now, std::vector<Event>& out, bool force = false);
+    void clear();
+
+    uint64_t suppressedTotal() const { return suppressedCount; }
+
+private:
+    struct KeyState {
+        Clock::time_point lastForwarded;
+        Clock::time_point firstSuppressed;  // Açık özet döneminin başı
+        bool forwarded = false;
+        int suppressed = 0;
+        int maxPriority = 0;
+        Event latest;         // Son bastırılan olay (özet metni için)
+    };
+
+    struct Bucket {
+        double tokens = 0.0;
+        Clock::time_point lastRefill;
+        bool initialized = false;
+    };
+
+    Policy policy;
+    std::unordered_map<std::string, KeyState> keys;  // "tip:anahtar"
+    std::unordered_map<int, Bucket> buckets;         // Tip başına
+    uint64_t suppressedCount;
+
+    bool takeToken(int type, Clock::time_point now);
+    static double seconds(Clock::duration d);
+};
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Sabit kapasiteli, kilitsiz, çok yazarlı uyarı halkası.
+// Yazarlar bilet (sıra numarası) alır ve yuvaya seqlock ile yazar; okuyucular
+// kilit almadan kopyalar ve yazım sırasında değişen kaydı atlar. Kayıt metinleri
+// sabit boyutlu alanlarda tutulur (uzunlar kırpılır); yuva içeriği atomik
+// sözcüklerle kopyalandığından eşzamanlı okuma tanımlı davranıştır.
+// Kapasite dolunca en eski kaydın üzerine yazılır.
+class AlertRing {
+public:
+    static constexpr size_t TIMESTAMP_SIZE = 20;   // "YYYY-MM-DD HH:MM:SS"
+    static constexpr size_t MESSAGE_SIZE = 192;
+    static constexpr size_t IMAGE_URL_SIZE = 160;
+
+    struct Entry {
+        uint64_t sequence;                  // 1'den başlayan yazım sırası
+        int32_t priority;
+        int32_t x;                          // Uyarı konumu
+        int32_t y;
+        char timestamp[TIMESTAMP_SIZE];
+        char message[MESSAGE_SIZE];
+        char imageUrl[IMAGE_URL_SIZE];
+
+        cv::Point location() const { return cv::Point(x, y); }
+    };
+
+    explicit AlertRing(size_t capacity);
+    // previous halkasının en yeni kayıtları (sırası korunarak) taşınır
+    AlertRing(size_t capacity, const AlertRing& previous);
+
+    AlertRing(const AlertRing&) = delete;
+    AlertRing& operator=(const AlertRing&) = delete;
+
+    // Herhangi bir iş parçacığından; kaydın sıra numarası döner
+    uint64_t push(const std::string& message, int priority,
+                  const cv::Point& location = cv::Point(),
+                  const std::string& imageUrl = "",
+                  std::chrono::system_clock::time_point time = std::chrono::system_clock::now());
+    // Önceki kayıtlar okuyuculardan gizlenir (yazarlar durmaz)
+    void clear();
+
+    // En yeniden eskiye en çok maxCount kayıt; visitor(const Entry&)
+    template <typename Visitor>
+    size_t visit(Visitor&& visitor, size_t maxCount = SIZE_MAX) const {
+        uint64_t newest = head.load(std::memory_order_acquire);
+        uint64_t oldest = oldestVisible(newest);
+        size_t count = 0;
+        Entry entry;
+        for (uint64_t sequence = newest; sequence > oldest && count < maxCount; sequence--) {
+            if (read(sequence, entry) == ReadResult::OK) {
+                visitor(static_cast<const Entry&>(entry));
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // cursor'dan sonraki kayıtlar eskiden yeniye; cursor ilerletilir.
+    // Henüz yazılmakta olan kayıtta durulur, sonraki çağrıda okunur.
+    template <typename Visitor>
+    size_t visitSince(uint64_t& cursor, Visitor&& visitor) const {
+        uint64_t newest = head.load(std::memory_order_acquire);
+        uint64_t sequence = std::max(cursor, oldestVisible(newest)) + 1;
+        size_t count = 0;
+        Entry entry;
+        for (; sequence <= newest; sequence++) {
+            ReadResult result = read(sequence, entry);
+            if (result == ReadResult::PENDING) break;
+            if (result == ReadResult::OK) {
+                visitor(static_cast<const Entry&>(entry));
+                count++;
+            }
+        }
+        cursor = sequence - 1;
+        return count;
+    }
+
+    uint64_t latestSequence() const { return head.load(std::memory_order_acquire); }
+    size_t capacity() const { return slotCount; }
+
+    // Saniye başına bir kez biçimlenen, iş parçacığına özel zaman damgası
+    static const char* formatTimestamp(std::chrono::system_clock::time_point time);
+
+private:
+    static constexpr size_t WORDS = (sizeof(Entry) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 2s-1: s yazılıyor, 2s: s hazır
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    enum class ReadResult { OK, PENDING, OVERWRITTEN };
+
+    const size_t slotCount;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<uint64_t> head;           // Verilen son sıra numarası
+    alignas(64) std::atomic<uint64_t> clearedThrough;  // Bu numaraya kadar gizli
+
+    uint64_t oldestVisible(uint64_t newest) const;
+    void write(uint64_t sequence, const Entry& entry);
+    ReadResult read(uint64_t sequence, Entry& out) const;
+};
\ No newline at end of file
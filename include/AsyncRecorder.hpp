@@ -0,0 +1,120 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "FrameClock.hpp"
+#include "RecordingIndex.hpp"
+#include "TrackingSystem.hpp"
+#include "VideoUtils.hpp"
+
+// Video kaydı için ayrı kodlayıcı iş parçacığı. submit() kareyi kopyalamaz:
+// cv::Mat başlığı (referans sayacı) sınırlı kuyruğa girer ve hemen döner;
+// kodlama (XVID/H264 1080p karede onlarca ms) ana döngünün süresinden
+// düşmez. Kodlayıcı geride kalırsa kuyruk dolar ve düşürme politikasına göre
+// kare atılır, sayaçlar artar. Her çıktı (dosya) kendi nesnesi ve iş
+// parçacığıyla yazılır. Çağıran, kuyruğa verdiği tampona sonradan
+// yazmamalıdır (bkz. VideoUtils::detachIfShared).
+// segmentSeconds > 0 ise kayıt medya zamanına göre <ad>_NNN segmentlerine
+// bölünür; her segmentin yanında kare zamanları ve iz kayıtlarını tutan
+// <ad>_NNN.idx dosyası yazılır (bkz. RecordingIndex).
+// idleFps > 0 ise sahnede hareketli iz yokken kareler kuyruğa girmeden
+// idleFps'e seyreltilir (kodlanmaz); hareket başlayınca tam hıza dönülür ve
+// activityHold süresi boyunca orada kalınır. Yazıcı FPS'i sabit olduğundan
+// sakin bölümler zaman atlamalı oynar; gerçek zamanlar .idx'tedir.
+class AsyncRecorder {
+public:
+    enum class DropPolicy {
+        DROP_NEWEST,   // Kuyruk doluysa gelen kare atılır
+        DROP_OLDEST    // Kuyruk doluysa en eski bekleyen kare atılır
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;       // Kuyruk dolu
+        uint64_t skipped = 0;       // Sakin sahnede seyreltilen (kodlanmadı)
+        uint64_t resized = 0;       // Yazıcı boyutuna ölçeklenen kare
+        uint32_t segments = 0;      // Açılan segment sayısı
+        uint32_t segmentErrors = 0; // Açılamayan segment (kayıt durdu)
+        size_t queued = 0;
+        size_t peakQueued = 0;
+        double encodeMillis = 0.0;  // Kare başına kodlama süresi (kayan ortalama)
+    };
+
+    explicit AsyncRecorder(size_t queueCapacity = 16,
+                           DropPolicy policy = DropPolicy::DROP_OLDEST);
+    ~AsyncRecorder();
+
+    AsyncRecorder(const AsyncRecorder&) = delete;
+    AsyncRecorder& operator=(const AsyncRecorder&) = delete;
+
+    // Yazıcıyı açar ve kodlayıcı iş parçacığını başlatır (açıksa önce durdurur)
+    bool start(const VideoUtils::RecordingConfig& config);
+    // drain: kuyruktaki kareler yazılıp dosya kapatılır; değilse atılır
+    void stop(bool drain = true);
+    // Segment açılamazsa kodlayıcı durur ve false döner; çağıran stop() etmeli
+    bool isRecording() const { return recording && !failed; }
+    const std::string& getFilename() const { return filename; }
+    // Segmentli kayıtta n. segmentin video yolu
+    std::string segmentPath(uint32_t index) const;
+
+    // Kareyi kodlama kuyruğuna alır; atılırsa false döner. Zaman damgası
+    // verilmezse kare sırası ve FPS'ten türetilir.
+    bool submit(const cv::Mat& frame);
+    // timestamp: karenin medya zamanı; tracks: karede görünen izler (yan
+    // dosyaya yazılır ve uyarlamalı kayıt hızını belirler)
+    bool submit(const cv::Mat& frame, MediaTime timestamp,
+                TrackingSystem::TrackSnapshotPtr tracks = nullptr);
+    Stats getStats();
+
+private:
+    struct Entry {
+        cv::Mat frame;
+        MediaTime timestamp;
+        bool timed;                 // false: zaman damgası kare sırasından
+        double wallTime;            // Unix saniye (submit anı)
+        TrackingSystem::TrackSnapshotPtr tracks;
+    };
+
+    size_t capacity;
+    DropPolicy policy;
+    cv::VideoWriter writer;     // Başladıktan sonra yalnızca kodlayıcı kullanır
+    cv::Size frameSize;
+    std::string filename;
+    VideoUtils::RecordingConfig config;
+    bool recording;             // Yalnızca sahip iş parçacığı değiştirir
+    std::atomic<bool> failed;   // Kodlayıcı segment açamadı
+
+    // Uyarlamalı hız durumu (yalnızca submit çağıran iş parçacığı)
+    bool hasActivity;
+    bool hasKept;
+    MediaTime lastActivity;
+    MediaTime lastKept;
+
+    // Kodlayıcı iş parçacığına ait segment durumu
+    RecordingIndex index;
+    uint32_t segment;
+    uint32_t segmentFrames;     // Segmentteki kare sayısı (konumlanma indeksi)
+    MediaTime segmentStart;
+    uint64_t framesTotal;
+
+    std::deque<Entry> frames;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopRequested;
+    bool drainOnStop;
+    Stats stats;                // queueMutex ile korunur
+    std::thread encoder;
+
+    void encoderLoop();
+    bool openSegment(uint32_t number, double wallTime);
+    void closeSegment();
+    bool enqueue(Entry entry);
+    bool shouldSkip(MediaTime timestamp, const TrackingSystem::TrackSnapshotPtr& tracks);
+    static bool hasMovingTracks(const TrackingSystem::TrackSnapshot& snapshot);
+};
\ No newline at end of file
@@ -15,8 +15,9 @@ public:
     bool isMoving;           // Is it moving?
     float velocity;          // Velocity (m/s)
     cv::Point2f direction;   // Movement direction
-    int trackId;             // Tracking ID
+    int trackId;             // Tracking ID (görünen ID, yuva anahtarı değil)
     cv::Mat faceImage;       // Face image if detected
+    std::string recognizedPerson; // Recognized person name (empty if unknown)
     std::vector<cv::Point> trajectory; // Movement trajectory
 
     // Constructors ve Destructor
@@ -0,0 +1,129 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include "FrameClock.hpp"
+#include "MpscQueue.hpp"
+
+// Süreç içi tipli olay veriyolu. Üreticiler (izleyici, detector, su seviyesi)
+// olayı bir kez yayımlar; her abonenin kendi sınırlı, kilitsiz kuyruğu vardır
+// ve olay paylaşılan işaretçiyle (kopyasız) her kuyruğa eklenir. Dolu kuyruk
+// yalnızca o abone için olayı düşürür: yavaş bir abone (bildirim, kayıt,
+// metrik, arayüz) üreticiyi ya da diğer aboneleri bekletmez.
+class EventBus {
+public:
+    // Olay türleri
+    struct TrackCreated { cv::Rect bbox; };
+    struct TrackLost {};
+    struct FaceRecognized { std::string person; };
+    struct ZoneEntered { int zone; std::string zoneName; };
+    struct ZoneExited { int zone; std::string zoneName; };
+    struct ZoneApproaching { int zone; std::string zoneName; double eta; };  // eta: saniye
+    struct SpeedViolation { double speed; };                                  // m/s
+    struct NightActivity {};
+    struct StationaryObject {};
+    struct WaterLevelThreshold { double level; double threshold; bool rising; bool critical; };
+    struct SystemStatus { std::string message; };
+
+    using Payload = std::variant<TrackCreated, TrackLost, FaceRecognized,
+                                 ZoneEntered, ZoneExited, ZoneApproaching,
+                                 SpeedViolation, NightActivity, StationaryObject,
+                                 WaterLevelThreshold, SystemStatus>;
+
+    struct Event {
+        Payload payload;
+        uint64_t id = 0;                    // publish() atar (süreç içinde artan)
+        int priority = 1;                   // 1-5
+        int trackId = -1;                   // İzin görünen ID'si; iz olayı değilse -1
+        std::string className;
+        MediaTime timestamp{0};             // Karenin medya zamanı
+        std::chrono::system_clock::time_point wallTime;
+        cv::Mat snapshot;                   // İsteğe bağlı görüntü (ROI, referans)
+    };
+    using EventPtr = std::shared_ptr<const Event>;
+    using Handler = std::function<void(const Event&)>;
+
+    class Subscription {
+    public:
+        Subscription(const std::string& name, size_t capacity);
+
+        // Tüketici iş parçacığından: bekleyen olayları sırayla işler
+        size_t drain(const Handler& handler, size_t maxEvents = SIZE_MAX);
+        bool poll(EventPtr& event) { return queue.tryPop(event); }
+
+        const std::string& name() const { return subscriberName; }
+        uint64_t deliveredCount() const { return delivered; }
+        uint64_t droppedCount() const { return dropped; }
+        size_t queuedCount() const { return queue.sizeApprox(); }
+
+    private:
+        friend class EventBus;
+
+        std::string subscriberName;
+        MpscQueue<EventPtr> queue;
+        std::atomic<uint64_t> delivered;
+        std::atomic<uint64_t> dropped;
+
+        // Yalnızca kendi iş parçacığı olan aboneler uyur
+        std::atomic<bool> waiting;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+    };
+    using SubscriptionPtr = std::shared_ptr<Subscription>;
+
+    struct SubscriberStats {
+        std::string name;
+        uint64_t delivered;
+        uint64_t dropped;
+        size_t queued;
+    };
+
+    EventBus();
+    ~EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Yoklamalı abone: olaylar çağıranın uygun gördüğü anda drain/poll ile alınır
+    SubscriptionPtr subscribe(const std::string& name, size_t capacity = DEFAULT_CAPACITY);
+    // Kendi iş parçacığında handler çağrılan abone
+    SubscriptionPtr subscribe(const std::string& name, Handler handler,
+                              size_t capacity = DEFAULT_CAPACITY);
+    void unsubscribe(const SubscriptionPtr& subscription);
+
+    // Herhangi bir iş parçacığından; kilitsiz (abone listesi RCU ile okunur)
+    void publish(Event event);
+    // Abone iş parçacıklarını durdurur (kuyruktakiler işlenir); yıkıcı çağırır
+    void shutdown();
+
+    uint64_t publishedCount() const { return published; }
+    std::vector<SubscriberStats> getStats() const;
+
+    // Olayın okunabilir metni ve birleştirme anahtarı (bildirim/arayüz için)
+    static std::string describe(const Event& event);
+    static std::string coalesceKey(const Event& event);
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    static constexpr int IDLE_WAIT_MS = 50;  // Kaçırılan uyandırmaya karşı üst sınır
+
+    using SubscriberList = std::vector<SubscriptionPtr>;
+
+    std::shared_ptr<const SubscriberList> subscribers;  // atomic_load/atomic_store ile
+    std::mutex subscribersMutex;                          // Yalnızca yazarlar
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopRequested;
+    std::atomic<uint64_t> published;
+
+    void addSubscriber(const SubscriptionPtr& subscription);
+    void runSubscriber(SubscriptionPtr subscription, Handler handler);
+};
\ No newline at end of file
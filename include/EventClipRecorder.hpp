@@ -0,0 +1,103 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "FrameClock.hpp"
+
+// Olay tetiklemeli klip kaydı. Son kareler düşük kaliteli JPEG olarak bellekte
+// bir halkada tutulur (sınır: bayt bütçesi ve ön kayıt süresi); kodlama ayrı
+// iş parçacığındadır, push() yalnızca cv::Mat başlığını kuyruğa alır.
+// trigger() halkadaki ön kaydı ve olaydan sonraki son kayıt süresini bir klip
+// dosyasına yazdırır ve dosyanın bağlantısını hemen döner. Açık bir klibin
+// süresi içinde gelen yeni olay yeni dosya açmaz; mevcut klibi uzatır.
+// Klip, yazım bitene kadar ".part.avi" adıyla durur, sonra yeniden adlandırılır.
+// Çağıran, push() ile verdiği tampona sonradan yazmamalıdır
+// (bkz. VideoUtils::detachIfShared).
+class EventClipRecorder {
+public:
+    struct Config {
+        std::string directory = "clips";
+        double preRollSeconds = 10.0;
+        double postRollSeconds = 10.0;
+        size_t memoryBudget = 48 * 1024 * 1024;  // Halka ve klip kuyrukları için ayrı ayrı
+        int jpegQuality = 70;
+        double fps = 0.0;                        // 0: kare zamanlarından ölçülür
+    };
+
+    struct Stats {
+        uint64_t encoded = 0;
+        uint64_t skipped = 0;          // Kodlama kuyruğu dolu
+        uint64_t clipsStarted = 0;
+        uint64_t clipsExtended = 0;
+        uint64_t clipsWritten = 0;
+        uint64_t clipFramesDropped = 0; // Bellek bütçesi dolu
+        uint64_t failed = 0;
+        size_t ringFrames = 0;
+        size_t ringBytes = 0;
+        double ringSeconds = 0.0;
+    };
+
+    explicit EventClipRecorder(const Config& config);
+    ~EventClipRecorder();
+
+    EventClipRecorder(const EventClipRecorder&) = delete;
+    EventClipRecorder& operator=(const EventClipRecorder&) = delete;
+
+    // Kareyi halkaya eklenmek üzere kuyruğa alır; beklemez
+    void push(const cv::Mat& frame, MediaTime timestamp);
+    // Olay klibini başlatır ya da açık klibi uzatır; bağlantı döner (boş: kapalı)
+    std::string trigger(const std::string& eventId, MediaTime eventTime);
+    void setPublicBaseUrl(const std::string& url);
+    Stats getStats();
+
+private:
+    static constexpr size_t INCOMING_CAPACITY = 4;
+
+    struct EncodedFrame {
+        MediaTime timestamp;
+        std::vector<uchar> jpeg;
+    };
+    using FramePtr = std::shared_ptr<const EncodedFrame>;
+
+    struct Clip {
+        std::string path;
+        std::string partPath;
+        MediaTime end;                 // Son kayıt bitişi
+        MediaTime lastTimestamp;       // Kliple paylaşılan son kare
+        std::deque<FramePtr> pending;  // Yazılmayı bekleyen kareler
+        bool closed = false;
+        // Yalnızca yazıcı iş parçacığı
+        cv::VideoWriter writer;
+        bool failed = false;
+    };
+    using ClipPtr = std::shared_ptr<Clip>;
+
+    Config config;
+    std::string publicBaseUrl;
+
+    std::mutex mutex;
+    std::condition_variable encodeCondition;
+    std::condition_variable clipCondition;
+    bool stopRequested;
+    std::deque<std::pair<cv::Mat, MediaTime>> incoming;
+    std::deque<FramePtr> ring;
+    size_t ringBytes;
+    size_t pendingBytes;               // Klip kuyruklarındaki kareler (halkayla paylaşılanlar dahil)
+    std::vector<ClipPtr> clips;
+    Stats stats;                       // mutex ile korunur
+    std::thread encoder;
+    std::thread writer;
+
+    void encoderLoop();
+    void writerLoop();
+    void appendLocked(const FramePtr& frame);
+    bool writeFrames(Clip& clip, const std::deque<FramePtr>& frames, cv::Mat& decoded);
+    double estimateFps(const std::deque<FramePtr>& frames) const;
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Kayıtlı kişilerin yüz tanımlayıcılarını tutan galeri.
+// Tanımlayıcılar sabit uzunlukta (DESCRIPTOR_SIZE) ve L2-normalize edilmiş olarak
+// tek bir bitişik matriste saklanır; arama tek bir GEMM çağrısıyla (kosinüs
+// benzerliği) yapılır. Yeni kişi eklemek yeniden eğitim gerektirmez.
+// Dosyaya bağlandığında galeri bellek eşlemeli (mmap) tutulur, açılış anlıktır.
+class FaceGallery {
+public:
+    static constexpr int DESCRIPTOR_SIZE = 128;  // Tanımlayıcı uzunluğu (float)
+    static constexpr int LABEL_SIZE = 64;        // Kayıt başına isim alanı (byte)
+    // İsim alanının son baytı satırın tanımlayıcı türünü tutar (0: eski kayıt,
+    // türü bilinmiyor; aramaya katılmaz, yeniden kaydedilmeli)
+    static constexpr int LABEL_TYPE_OFFSET = LABEL_SIZE - 1;
+
+    // Tanımlayıcı türü; benzerlik dağılımları farklı olduğundan eşikler ayrıdır
+    enum class DescriptorType {
+        EMBEDDING = 1,   // DNN yüz gömmesi
+        GRADIENT = 2     // Model yokken gradyan histogramı (tüm bileşenler >= 0)
+    };
+
+    struct Match {
+        int index = -1;            // Galerideki satır (-1: eşleşme yok)
+        std::string name;          // Kişi adı
+        float similarity = 0.0f;   // Kosinüs benzerliği
+    };
+
+    FaceGallery();
+    ~FaceGallery();
+
+    FaceGallery(const FaceGallery&) = delete;
+    FaceGallery& operator=(const FaceGallery&) = delete;
+
+    // Galeri dosyasını aç (yoksa oluştur). Başarısız olursa bellek içi çalışır.
+    // Dosyalı galeri büyütülürken yeniden eşlenemezse galeri kapanır ve
+    // open() çağrılana kadar kayıt kabul etmez (isFailed).
+    bool open(const std::string& path);
+    void close();
+    void flush();
+    bool isPersistent() const;
+    bool isFailed() const;
+
+    // İsteğe bağlı 128 boyutlu yüz gömme modeli (ör. OpenFace nn4.small2)
+    bool setEmbeddingModel(const std::string& modelPath);
+
+    // Tanımlayıcı çıkarımı ve kayıt
+    cv::Mat computeDescriptor(const cv::Mat& face, DescriptorType* type = nullptr);
+    int enroll(const cv::Mat& face, const std::string& name);
+    int enrollDescriptor(const cv::Mat& descriptor, const std::string& name,
+                         DescriptorType type);
+
+    // En yakın komşu araması; yalnızca sorguyla aynı türdeki satırlar (farklı
+    // uzaylardaki vektörler karşılaştırılmaz). Model sonradan eklenir ya da
+    // kaldırılırsa kişiler yeni türle yeniden kaydedilmelidir.
+    Match search(const cv::Mat& descriptor, DescriptorType type) const;
+    Match identify(const cv::Mat& face);
+
+    void setMatchThreshold(DescriptorType type, float threshold);
+    float getMatchThreshold(DescriptorType type) const;
+    size_t size() const;
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t dimension;
+        uint64_t count;
+        uint64_t capacity;
+        uint8_t reserved[32];
+    };
+    static_assert(sizeof(Header) == 64, "Galeri başlığı 64 byte olmalı");
+
+    mutable std::mutex galleryMutex;
+    std::mutex embeddingMutex;
+    cv::dnn::Net embeddingNet;
+    bool hasEmbeddingNet = false;    // embeddingMutex ile korunur
+    float embeddingThreshold = 0.85f;
+    float gradientThreshold = 0.96f; // Negatif olmayan histogramlar birbirine yakın
+    bool failed = false;             // Yeniden eşleme başarısız; galeri kapalı
+
+    // Bellek eşlemeli bölge: [Header][capacity x DESCRIPTOR_SIZE float][capacity x LABEL_SIZE]
+    int fd = -1;
+    uint8_t* mapping = nullptr;
+    size_t mappingSize = 0;
+
+    Header* header() const { return reinterpret_cast<Header*>(mapping); }
+    float* descriptorRow(size_t row) const;
+    char* labelSlot(size_t row) const;
+
+    bool reserve(uint64_t capacity);
+    bool mapRegion(uint64_t capacity);
+    void unmapRegion();
+    static size_t regionSize(uint64_t capacity);
+    static size_t labelOffset(uint64_t capacity);
+};
\ No newline at end of file
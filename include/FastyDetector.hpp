@@ -1,14 +1,20 @@
 #pragma once
 #include <opencv2/opencv.hpp>
-#include <opencv2/face.hpp>
 #include <vector>
 #include <string>
 #include <deque>
 #include <map>
 #include <memory>
+#include "AlertRing.hpp"
 #include "Detection.hpp"
+#include "FaceGallery.hpp"
 #include "TrackingSystem.hpp"
+#include "EventBus.hpp"
 #include "NotificationSystem.hpp"
+#include "SnapshotEncoder.hpp"
+#include "EventClipRecorder.hpp"
+#include "FrameClock.hpp"
+#include "LabelCache.hpp"
 
 class FastyDetector {
 public:
@@ -32,6 +38,7 @@ public:
         bool showFPS = true;
         bool showNotifications = true;
         bool loopVideo = true;
+        bool headless = false;  // Pencere ve ekran çizimi yok (sunucu kurulumu)
     };
 
     // Use the Detection struct from Detection.hpp
@@ -51,6 +58,7 @@ public:
         float maxDetectionHeight = 400.0f; // Maximum detection height
         bool enableNightVision = false;    // Night vision mode
         bool enableFaceRecognition = false; // Face recognition
+        size_t maxAlerts = 64;             // Alert ring capacity (config: alerts.max_alerts)
     };
 
     // Alert structure
@@ -78,6 +86,7 @@ public:
     cv::VideoCapture& getCapture() { return capture; }
     const cv::VideoCapture& getCapture() const { return capture; }
     double getCurrentFPS() const { return currentFPS; }
+    MediaTime getFrameTimestamp() const { return frameClock.now(); }
     int getCurrentFrame() const;
     int getTotalFrames() const;
 
@@ -93,7 +102,9 @@ public:
                               const std::string& webhookUrl,
                               const std::string& pushoverToken);
     void setNotificationPriority(int priority);
-    std::vector<TrackingSystem::TrackedObject> getTrackedObjects() const;
+    TrackingSystem::TrackSnapshotPtr getTrackedObjects() const;
+    // İz/bölge olayları; kayıt, metrik vb. bileşenler buradan abone olur
+    std::shared_ptr<EventBus> getEventBus() const { return eventBus; }
     void enableFaceRecognition(bool enable);
     void addKnownFace(const cv::Mat& faceImage, const std::string& personName);
     
@@ -117,18 +128,29 @@ public:
     void drawDetections(cv::Mat& frame, const std::vector<Detection>& detections);
     void drawInfo(cv::Mat& frame, const std::string& info);
     void drawTrajectories(cv::Mat& frame);
+    LabelCache::Stats getLabelCacheStats() const { return labelCache.getStats(); }
     
     // Alerts and notifications
-    void addAlert(const std::string& message, int priority = 1);
+    // coalesceKey: aynı olayın tekrarlarını birleştirmek için (boş: mesaj metni)
+    // snapshot: uyarıya eklenecek görüntü; yalnızca bildirim kabul edilirse kodlanır
+    void addAlert(const std::string& message, int priority = 1,
+                  const std::string& coalesceKey = "",
+                  const cv::Mat& snapshot = cv::Mat());
     std::vector<Alert> getAlerts() const;
+    // Kopyasız okuma için halka (visit/visitSince); herhangi bir iş parçacığından
+    std::shared_ptr<const AlertRing> getAlertRing() const;
     void clearAlerts();
     void sendNotification(const std::string& message, int priority);
+    // Kareyi arka planda JPEG olarak kaydeder; dosya yolu döner (boş: kuyruk dolu)
+    std::string saveSnapshot(const cv::Mat& frame, const std::string& prefix);
 
 private:
     // Basic members
     cv::dnn::Net net;
     std::vector<std::string> classes;
     std::vector<cv::Scalar> colors;
+    LabelCache labelCache;  // Tespit etiketi sprite'ları (çizim iş parçacığı)
+    std::string labelText;  // Etiket arama tamponu
     Settings settings;
     InputSettings inputSettings;
     
@@ -136,25 +158,33 @@ private:
     cv::VideoCapture capture;
     bool isInitialized = false;
     double currentFPS = 0.0;
+    FrameClock frameClock;                                   // Kare başına medya zamanı
+    std::chrono::steady_clock::time_point lastFrameWallTime; // İşleme FPS'i için
     
     // Advanced systems
     std::unique_ptr<TrackingSystem> trackingSystem;
     std::unique_ptr<NotificationSystem> notificationSystem;
-    cv::Ptr<cv::face::FaceRecognizer> faceRecognizer;
+    std::shared_ptr<FaceGallery> faceGallery;
+    std::shared_ptr<SnapshotEncoder> snapshotEncoder;
+    std::shared_ptr<EventClipRecorder> clipRecorder;  // Ön kayıt halkası, olay klipleri
+    std::shared_ptr<EventBus> eventBus;
+    EventBus::SubscriptionPtr alertEvents;  // Arayüz uyarı listesi (detect içinde yoklanır)
     bool nightVisionEnabled = false;
     
-    // Motion tracking
-    std::map<int, Detection> previousDetections;
-    float deltaTime = 0.033f; // ~30 FPS
-    
     // Alerts
-    std::deque<Alert> alerts;
-    const size_t MAX_ALERTS = 10;
+    std::shared_ptr<AlertRing> alerts;  // atomic_load/atomic_store ile (boyut değişimi)
     
     // Constants
     const float FOCAL_LENGTH = 615.0f;    // Camera focal length
     const float PERSON_HEIGHT = 1.7f;     // Average person height (meters)
     const float DANGER_SPEED = 2.0f;      // Dangerous speed threshold (m/s)
+    const std::string FACE_GALLERY_PATH = "models/faces.gallery";
+    const std::string FACE_EMBEDDING_MODEL = "models/openface.nn4.small2.v1.t7";
+    const std::string NOTIFICATION_SPOOL_DIR = "spool/notifications";
+    const std::string SNAPSHOT_DIR = "snapshots";
+    const std::string CLIP_DIR = "clips";
+    const int NOTIFY_MIN_PRIORITY = 2;    // Bu öncelikten itibaren olay dış bildirime gider
+    const int CLIP_MIN_PRIORITY = 3;      // Bu öncelikten itibaren olay klibi kaydedilir
     
     // Helper functions
     void generateColors();
@@ -162,13 +192,13 @@ private:
     std::vector<Detection> postprocess(const cv::Mat& frame, 
                                      const std::vector<cv::Mat>& outs);
     float calculateDistance(const cv::Rect& bbox);
-    void checkDangerousConditions(const Detection& det);
+    void checkDangerousConditions(const Detection& det, const cv::Mat& frame);
+    void resizeAlerts(size_t capacity);
+    void collectEventAlerts();
+    void notifyEvent(const EventBus::Event& event);  // Veriyolu iş parçacığında
     cv::Mat enhanceFrame(const cv::Mat& frame);
     cv::Mat adjustContrast(const cv::Mat& frame);
     cv::Mat reduceNoise(const cv::Mat& frame);
-    void updateMotionTracking(std::vector<Detection>& detections);
-    float calculateVelocity(const cv::Point& current, const cv::Point& previous);
-    cv::Point2f calculateDirection(const cv::Point& current, const cv::Point& previous);
     cv::Mat applyNightVision(const cv::Mat& frame);
     bool detectFace(const cv::Mat& frame, cv::Rect& faceRect);
     void processFaceRecognition(Detection& detection);
@@ -0,0 +1,31 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <chrono>
+
+// Medya zaman tabanı (saniye). Hız, iz yaşlanması ve uyarılar duvar saatine
+// değil bu zamana göre hesaplanır; böylece dosyalar gerçek zamandan hızlı veya
+// yavaş işlense de sonuçlar canlı yayınla aynı olur.
+using MediaTime = std::chrono::duration<double>;
+
+// Her kare için tekdüze artan medya zaman damgası üretir.
+// Video dosyasında CAP_PROP_POS_MSEC (yoksa kare indeksi / FPS), kamerada
+// yakalama anı kullanılır. Video başa sarıldığında zaman geri gitmez.
+class FrameClock {
+public:
+    FrameClock();
+
+    void reset();
+    MediaTime stamp(const cv::VideoCapture& capture, bool isCamera);
+
+    MediaTime now() const { return current; }
+    MediaTime delta() const { return current - previous; }
+
+private:
+    MediaTime current;
+    MediaTime previous;
+    MediaTime lastSourceTime;   // Kaynağın ham zamanı (döngü tespiti için)
+    MediaTime loopOffset;       // Başa sarmalarda biriken ofset
+    MediaTime frameInterval;    // Nominal kare aralığı
+    bool started;
+    std::chrono::steady_clock::time_point origin;
+};
\ No newline at end of file
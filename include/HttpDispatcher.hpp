@@ -0,0 +1,80 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "curl/curl.h"
+
+// curl multi arayüzü üzerinde eşzamanlı HTTP POST gönderimi.
+// Bağlantılar multi tutamacının önbelleğinde canlı (keep-alive) tutulur ve
+// easy tutamaçları yeniden kullanılır; aynı uç noktaya giden istekler yeni
+// TCP/TLS el sıkışması yapmaz. Başlık listeleri bir kez oluşturulur.
+// Tek iş parçacığından kullanılmak üzere tasarlanmıştır.
+class HttpDispatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class ContentType {
+        JSON,
+        FORM
+    };
+
+    struct Result {
+        std::string url;
+        long tag;          // post() ile verilen çağıran etiketi
+        long status;       // HTTP durum kodu (0: bağlantı hatası)
+        bool ok;           // 2xx yanıt alındı mı?
+        double seconds;    // Kuyruğa alınmadan tamamlanmaya kadar geçen süre
+    };
+
+    struct Stats {
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        double totalSeconds = 0.0;
+        double maxSeconds = 0.0;
+    };
+
+    explicit HttpDispatcher(int maxInFlight = 8, long timeoutSeconds = 10);
+    ~HttpDispatcher();
+
+    HttpDispatcher(const HttpDispatcher&) = delete;
+    HttpDispatcher& operator=(const HttpDispatcher&) = delete;
+
+    // İsteği kuyruğa al; gövde taşınır ve istek bitene kadar yaşar
+    void post(const std::string& url, std::string body, ContentType type, long tag = -1);
+    // Kuyruktaki ve uçuştaki tüm istekler tamamlanana kadar multi döngüsünü sür
+    void runUntilIdle();
+
+    size_t pending() const { return waiting.size() + static_cast<size_t>(inFlight); }
+    const Stats& getStats() const { return stats; }
+    void setCompletionCallback(std::function<void(const Result&)> callback);
+
+private:
+    struct Request {
+        std::string url;
+        std::string body;
+        ContentType type;
+        long tag;
+        Clock::time_point queued;
+        CURL* handle = nullptr;
+    };
+
+    CURLM* multi;
+    int maxInFlight;
+    long timeoutSeconds;
+    int inFlight;
+    std::vector<CURL*> idleHandles;
+    std::deque<std::unique_ptr<Request>> waiting;
+    curl_slist* jsonHeaders;
+    curl_slist* formHeaders;
+    Stats stats;
+    std::function<void(const Result&)> onComplete;
+
+    CURL* acquireHandle();
+    void startWaiting();
+    void collectCompleted();
+    static size_t DiscardCallback(void* contents, size_t size, size_t nmemb, void* userp);
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Önceden ayrılmış tampona yazan küçük JSON serileştirici.
+// Dizgiler RFC 8259'a göre kaçışlanır (", \, kontrol karakterleri); virgüller
+// otomatik yerleştirilir. Tampon clear() ile kapasitesi korunarak yeniden kullanılır.
+class JsonWriter {
+public:
+    explicit JsonWriter(size_t reserveBytes = 1024);
+
+    void clear();
+    const std::string& str() const { return buffer; }
+    std::string release();
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    JsonWriter& key(const std::string& name);
+    JsonWriter& value(const std::string& text);
+    JsonWriter& value(const char* text);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(double number);
+    JsonWriter& value(bool flag);
+
+    // Kaçışlanmış dizgiyi tırnaklarıyla birlikte out'a ekler
+    static void appendEscaped(std::string& out, const std::string& text);
+
+private:
+    std::string buffer;
+    bool needComma;  // Sıradaki eleman virgülle ayrılmalı mı?
+
+    void separate();
+};
\ No newline at end of file
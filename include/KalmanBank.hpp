@@ -0,0 +1,52 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// İz başına sabit hızlı (constant-velocity) Kalman filtresi.
+// Tüm izlerin durumu SoA dizilerinde tutulur ve tahmin adımı tek döngüde
+// toplu yapılır. x ve y eksenleri bağımsız modellenir; gürültüler aynı
+// olduğundan iki eksenin 2x2 kovaryansı ortaktır (p00, p01, p11).
+// Kutu boyutu (w, h) üstel ortalama ile yumuşatılır.
+class KalmanBank {
+public:
+    KalmanBank();
+
+    // Yeni iz ekle; dönen indeks iz dizisindeki indeksle aynı tutulmalı
+    int add(const cv::Rect& box);
+    // Son elemanı indeksin yerine taşıyarak sil (iz dizisi de aynı şekilde)
+    void swapRemove(int index);
+    void clear();
+    size_t size() const { return cx.size(); }
+
+    // Tüm izler için tahmin adımı
+    void predict(float dt);
+    // Eşleşen ölçümle düzeltme adımı
+    void correct(int index, const cv::Rect& measurement);
+    // Uzun süre ölçüm almayan izi yerinde durdur: hız sıfırlanır ve
+    // bilinmez kabul edilir; sonraki tahminler konumu ilerletmez
+    void hold(int index);
+
+    cv::Rect predictedBox(int index) const;
+    cv::Point2f position(int index) const { return cv::Point2f(cx[index], cy[index]); }
+    cv::Point2f velocity(int index) const { return cv::Point2f(vx[index], vy[index]); }
+
+    // Mevcut durumu dt adımlarla ileri sar (alt piksel hassasiyetinde)
+    std::vector<cv::Point2f> extrapolate(int index, float dt, int steps) const;
+    // Seçili izlerin konumu ve horizon saniye sonraki tahmini konumu (toplu)
+    void project(const std::vector<int>& indices, float horizon,
+                 std::vector<cv::Point2f>& from, std::vector<cv::Point2f>& to) const;
+
+    void setNoise(float processNoise, float measurementNoise);
+
+private:
+    // Durum (piksel, piksel/saniye)
+    std::vector<float> cx, cy, vx, vy;
+    std::vector<float> width, height;
+    // Ortak eksen kovaryansı
+    std::vector<float> p00, p01, p11;
+
+    float processNoise;      // İvme spektral yoğunluğu (piksel^2/s^3)
+    float measurementNoise;  // Merkez ölçüm varyansı (piksel^2)
+    float initialVelocityVariance;
+    float sizeSmoothing;
+};
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Metin etiketleri için LRU sprite önbelleği. Hershey yazı rasterleştirmesi
+// kutu başına pahalıdır; aynı (metin, yazı tipi, ölçek, kalınlık, renk, zemin)
+// ikilisi bir kez zemin rengi üzerine çizilir ve sonraki karelerde yalnızca
+// kopyalanır. Ölçüler (getTextSize) de önbellekten gelir. Sınıf adları ve
+// nicemlenmiş mesafe/hız metinleri kareler arasında büyük ölçüde tekrarlanır.
+// İş parçacığı güvenli değildir; çizim iş parçacığına aittir.
+class LabelCache {
+public:
+    struct Style {
+        int fontFace = cv::FONT_HERSHEY_SIMPLEX;
+        double scale = 0.5;
+        int thickness = 1;
+        cv::Scalar color = cv::Scalar(255, 255, 255);
+        cv::Scalar background = cv::Scalar(0, 0, 0);
+    };
+
+    struct Label {
+        cv::Mat sprite;      // Zemin üzerine çizilmiş metin (PADDING kenar payıyla)
+        cv::Size textSize;   // getTextSize sonucu
+        int baseline = 0;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    explicit LabelCache(size_t capacity = 512);
+
+    // Önbellekteki etiket (yoksa rasterleştirilir); referans bir sonraki
+    // get() çağrısına kadar geçerlidir
+    const Label& get(const std::string& text, const Style& style);
+    // putText ile aynı taban çizgisi kökeni; kare dışına taşan kısım kırpılır
+    static void blit(cv::Mat& frame, const Label& label, const cv::Point& origin);
+
+    void setCapacity(size_t capacity);
+    void clear();
+    Stats getStats() const;
+
+private:
+    static constexpr int PADDING = 2;  // Glifler kökenin biraz soluna taşabilir
+
+    using Entry = std::pair<std::string, Label>;
+    std::list<Entry> entries;  // Baş: en son kullanılan
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t capacity;
+    std::string keyBuffer;     // Arama anahtarı (ısınmadan sonra bellek ayırmaz)
+    Stats stats;
+
+    void buildKey(const std::string& text, const Style& style);
+    void evict();
+};
\ No newline at end of file
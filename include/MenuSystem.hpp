@@ -3,6 +3,7 @@
 #include <string>
 #include <functional>
 #include <map>
+#include <cstdint>
 
 class MenuSystem {
 public:
@@ -38,11 +39,15 @@ public:
     // Menü işlemleri
     void show(MenuType type);
     void handleInput(int key);
-    void toggleVisibility() { isVisible = !isVisible; }
+    void toggleVisibility() { isVisible = !isVisible; revision++; }
     bool isMenuVisible() const { return isVisible; }
     
     // Menü çizimi
     void draw(cv::Mat& frame);
+    // BGRA katman tuvaline çizer (yarı saydam zemin + metin); içerik yalnızca
+    // getRevision() değiştiğinde yeniden çizilmelidir
+    void renderLayer(cv::Mat& canvas);
+    uint64_t getRevision() const { return revision; }
     
     // Kısayol işlemleri
     void showShortcuts() const;
@@ -52,6 +57,7 @@ private:
     FastyDetector& detector;
     MenuType currentMenu = MenuType::MAIN;
     bool isVisible = false;
+    uint64_t revision = 0;  // Görünen menü içeriği her değiştiğinde artar
     std::map<MenuType, std::map<int, MenuItem>> menus;
     std::map<char, std::function<void()>> shortcuts;
 
@@ -66,6 +72,8 @@ private:
     
     // Yardımcı fonksiyonlar
     void drawMenu(const cv::Mat& frame, const std::map<int, MenuItem>& menu);
+    void drawItems(cv::Mat& frame, const std::map<int, MenuItem>& menu, const cv::Scalar& color);
+    static std::string itemLabel(int key, const MenuItem& item);
     void clearScreen();
     void showNotification(const std::string& message);
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Bildirimler için diskte kalıcı, yalnızca eklemeli kayıt günlüğü (WAL).
+// Kayıtlar sıra numarasıyla segment dosyalarına yazılır; her append tek
+// write + fdatasync ile toplu yapılır. Onaylanan (gönderilen) kayıtlar
+// kesintisiz ilerleyen bir checkpoint'e dönüşür; checkpoint'in tamamen
+// gerisinde kalan segmentler silinir. Açılışta checkpoint sonrası kayıtlar
+// yeniden okunabilir. Kayıt: [uzunluk:u32][crc32:u32][sıra:u64][veri]
+// Yarım yazılmış kuyruk kayıtları CRC ile tanınır ve atlanır.
+// Checkpoint dosyası sırasız onayları ve kayıt işaretlerini (ör. teslim edilmiş
+// kanallar) de tutar; yeniden başlatmada bunlar kaybolmaz. Vazgeçilen kayıtlar
+// aynı biçimle dead-letter günlüğüne yazılır.
+// İş parçacığı güvenli değildir; çağıran kilitler.
+class NotificationSpool {
+public:
+    struct Record {
+        uint64_t sequence;
+        std::string payload;
+        uint8_t marks = 0;  // mark() ile verilen bayraklar
+    };
+
+    NotificationSpool();
+    ~NotificationSpool();
+
+    NotificationSpool(const NotificationSpool&) = delete;
+    NotificationSpool& operator=(const NotificationSpool&) = delete;
+
+    bool open(const std::string& directory);
+    void close();
+    bool isOpen() const { return segmentFd >= 0; }
+
+    // Kayıtları ekler ve diske işler; ilk kaydın sıra numarası döner (0: hata)
+    uint64_t append(const std::vector<std::string>& payloads);
+    void acknowledge(uint64_t sequence);
+    // Onaylanmamış kayda bayrak ekler (OR); commit ile kalıcı olur
+    void mark(uint64_t sequence, uint8_t flags);
+    // Kaydın kopyasını dead-letter günlüğüne ekler (onay çağıranın işi)
+    bool deadLetter(uint64_t sequence, const std::string& payload);
+    // Checkpoint'i diske yazar ve artık gerekmeyen segmentleri siler
+    bool commit();
+
+    // Checkpoint sonrası henüz onaylanmamış kayıtlar (sıra numarasına göre)
+    std::vector<Record> readUnacknowledged() const;
+    uint64_t unacknowledgedCount() const;
+    uint64_t checkpointSequence() const { return checkpoint; }
+
+private:
+    static constexpr size_t SEGMENT_BYTES = 4 * 1024 * 1024;
+
+    std::string directory;
+    int segmentFd;
+    size_t segmentSize;
+    std::vector<uint64_t> segmentStarts;  // Segmentlerin ilk sıra numaraları (artan)
+    uint64_t nextSequence;
+    uint64_t checkpoint;                  // Bu numaraya kadar her şey onaylı
+    std::set<uint64_t> acknowledged;      // Checkpoint sonrası sırasız onaylar
+    std::map<uint64_t, uint8_t> marks;    // Checkpoint sonrası kayıt işaretleri
+    bool checkpointDirty;
+    std::string writeBuffer;
+
+    std::string segmentPath(uint64_t firstSequence) const;
+    void encodeRecord(uint64_t sequence, const std::string& payload);
+    bool startSegment();
+    void readSegment(uint64_t firstSequence, std::vector<Record>& out,
+                     uint64_t* lastSequence) const;
+};
\ No newline at end of file
@@ -1,10 +1,30 @@
 #pragma once
 #include <string>
-#include <queue>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <map>
+#include <thread>
+#include <vector>
 #include "curl/curl.h"
+#include "AlertCoalescer.hpp"
+#include "HttpDispatcher.hpp"
+#include "JsonWriter.hpp"
+#include "NotificationSpool.hpp"
 
+// Bildirimler öncelik şeritli, sınırlı bir kuyruğa alınır ve tek bir dispatcher
+// iş parçacığı tarafından gönderilir; üretici (kare işleme) ağ çağrısı beklemez.
+// Dispatcher kuyruktan tur tur alır; bir turun HTTP istekleri curl multi ile
+// eşzamanlı ve kalıcı bağlantılar üzerinden gider. Spool açıksa kuyruktan
+// alınan bildirimler gönderimden önce diske yazılır; başarısızlar geri çekilmeli
+// (backoff) olarak yeniden denenir ve yeniden başlatmada diskten okunur.
+// Email (SMTP, bloklayan easy arayüzü) ayrı bir iş parçacığında gider; acil
+// bildirimlerin HTTP turlarını geciktirmez.
 class NotificationSystem {
 public:
     enum class NotificationType {
@@ -22,6 +42,13 @@ public:
         std::string timestamp;
         int priority;
         std::string imageUrl;
+        std::string coalesceKey = "";  // Birleştirme anahtarı (boş: mesaj metni)
+        // Bildirim kabul edilirse çağrılır ve imageUrl'i üretir (ör. anlık görüntü
+        // kodlama kuyruğu); tekrar olarak bastırılan bildirimler görüntü üretmez
+        std::function<std::string()> imageProvider = nullptr;
+        std::string clipUrl = "";      // Olay klibi (ön + son kayıt)
+        // imageProvider gibi; kabul edilen bildirim için klip kaydını başlatır
+        std::function<std::string()> clipProvider = nullptr;
     };
 
     NotificationSystem();
@@ -31,27 +58,129 @@ public:
                    const std::string& webhookUrl,
                    const std::string& pushoverToken);
                    
-    void sendNotification(const Notification& notification);
-    void sendPushover(const std::string& message, int priority = 0);
-    void sendWebhook(const Notification& notification);
-    void sendEmail(const std::string& recipient, const std::string& subject, 
-                  const std::string& message);
+    // Bildirimi kuyruğa alır ve hemen döner; gönderim dispatcher iş parçacığında.
+    // Filtre ya da birleştirme nedeniyle alınmazsa false döner.
+    bool sendNotification(const Notification& notification);
+    // Dispatcher'ı durdurur; drain ise kuyruktakiler timeout dolana kadar
+    // gönderilir, kalanlar spool'da bir sonraki çalıştırmaya kalır (yıkıcı çağırır).
+    // Uçuştaki bir istek zaman aşımı kadar (10 sn) daha sürebilir.
+    void shutdown(bool drain = true,
+                  std::chrono::milliseconds timeout = std::chrono::seconds(10));
 
     // Bildirim filtresi ve yönetimi
     void setMinPriority(int priority) { minPriority = priority; }
     void enableNotificationType(NotificationType type, bool enable);
     void clearNotifications();
     std::vector<Notification> getRecentNotifications(int count = 10);
+    uint64_t getDroppedCount() const { return droppedCount; }
+    
+    // Tekrar bastırma, hız sınırı ve özet ayarları
+    void setCoalescingPolicy(const AlertCoalescer::Policy& policy);
+    // Toplu webhook: bir turdaki olaylar tek POST'ta JSON dizisi olarak gider
+    void setWebhookBatching(bool enable, size_t maxBatchSize = 50);
+    HttpDispatcher::Stats getDeliveryStats();
+    // Kalıcı bildirim kuyruğu; gönderilmemiş kayıtlar yeniden denenir
+    bool enableSpool(const std::string& directory);
+    uint64_t getPendingCount();
+    // Kalıcı hata (4xx) ya da deneme sınırı nedeniyle vazgeçilen bildirimler
+    uint64_t getDeadLetterCount() const { return deadLetterCount; }
 
 private:
-    std::queue<Notification> notificationQueue;
+    // Öncelik şeritleri: 5+ acil, 3-4 yüksek, diğerleri normal
+    static constexpr int LANE_COUNT = 3;
+    static constexpr size_t LANE_CAPACITY = 256;
+    static constexpr size_t MAX_HISTORY = 50;
+    static constexpr int SUMMARY_POLL_MS = 1000;  // Özet kontrol aralığı
+    static constexpr int MAX_IN_FLIGHT = 8;       // Eşzamanlı HTTP isteği
+    static constexpr size_t ROUND_SIZE = 32;      // Toplu mod kapalıyken tur boyu
+    static constexpr size_t MAX_BACKLOG = 10000;  // Bellekteki gönderilmemiş bildirim
+    static constexpr double MAX_BACKOFF_SECONDS = 300.0;
+    static constexpr int MAX_ATTEMPTS = 8;        // Sonrası dead-letter
+    static constexpr long BATCH_TAG = -2;         // Toplu webhook isteğinin etiketi
+    static constexpr size_t EMAIL_QUEUE_CAPACITY = 64;
+
+    // Teslim kanalları (bit maskesi). Her kanal ayrı izlenir: yeniden denemede
+    // yalnızca başarısız kanal tekrar gönderilir
+    enum Channel : uint8_t {
+        CHANNEL_PUSHOVER = 1 << 0,
+        CHANNEL_WEBHOOK  = 1 << 1,
+        CHANNEL_EMAIL    = 1 << 2   // Yalnızca ilk denemede; onaya katılmaz
+    };
+    static constexpr long CHANNEL_TAGS = 2;       // İstek etiketi = indeks * 2 + kanal
+
+    using Clock = std::chrono::steady_clock;
+
+    // Dispatcher'ın gönderim bekleyen bildirimi
+    struct Pending {
+        uint64_t sequence;      // Spool sıra numarası (0: spool kapalı)
+        Notification notification;
+        int attempts;
+        Clock::time_point due;  // Bir sonraki deneme zamanı
+        uint8_t delivered = 0;  // Başarıyla teslim edilmiş kanallar (Channel)
+    };
+
+    std::array<std::deque<Notification>, LANE_COUNT> lanes;
     std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopRequested;
+    bool drainOnStop;
+    Clock::time_point drainDeadline;  // queueMutex ile korunur
+    std::thread dispatcher;
+    std::atomic<uint64_t> droppedCount;
+    AlertCoalescer coalescer;  // queueMutex ile korunur
+    bool batchWebhooks;        // queueMutex ile korunur
+    size_t maxBatchSize;
+
+    std::deque<Notification> history;  // Gönderilen son bildirimler
+    std::mutex historyMutex;
+
     std::string apiKey;
     std::string webhookUrl;
     std::string pushoverToken;
-    int minPriority;
-    std::map<NotificationType, bool> enabledTypes;
-    CURL* curl;
+    std::mutex configMutex;
+    std::atomic<int> minPriority;
+    std::map<NotificationType, bool> enabledTypes;  // queueMutex ile korunur
+    CURL* curl;           // SMTP için; yalnızca email iş parçacığı kullanır
+    HttpDispatcher http;  // Yalnızca dispatcher iş parçacığı kullanır
+    JsonWriter json;
+    HttpDispatcher::Stats deliveryStats;  // historyMutex ile korunur
+
+    // Dispatcher'a özel gönderim birikimi (şerit sırasıyla)
+    std::array<std::deque<Pending>, LANE_COUNT> backlog;
+    size_t backlogSize;
+    std::vector<uint8_t> roundSent;       // Tur içinde gönderilen kanallar (bildirim başına)
+    std::vector<uint8_t> roundFailed;     // Tur içinde başarısız kanallar
+    std::vector<uint8_t> roundPermanent;  // Yeniden denenmeyecek hatalar (4xx)
+    NotificationSpool spool;
+    std::mutex spoolMutex;
+    std::atomic<uint64_t> pendingCount;
+    std::atomic<uint64_t> deadLetterCount;
+
+    // Email iş parçacığı: dispatcher mesajı kuyruğa bırakır ve devam eder
+    std::deque<std::string> emailQueue;
+    std::mutex emailMutex;
+    std::condition_variable emailCondition;
+    bool emailStop;
+    Clock::time_point emailDeadline;  // emailMutex ile korunur
+    std::thread emailWorker;
+
+    static int laneFor(int priority);
+    void enqueueLocked(const Notification& notification);
+    void enqueueSummariesLocked(bool force);
+    void queuePushover(const std::string& token, const std::string& user,
+                       const std::string& message, int priority, long tag);
+    void writeNotification(const Notification& notification);
+    void queueEmail(const std::string& message);
+    void sendEmail(const std::string& recipient, const std::string& subject, 
+                  const std::string& message);
+    void processEmailQueue();
+    void deliverRound(const std::vector<Pending>& round, bool batched);
+    void spoolIncoming(std::vector<Notification>& incoming);
+    void pushBacklog(Pending pending);
+    bool takeRound(std::vector<Pending>& round, size_t limit, bool ignoreDue);
+    bool hasDueBacklog() const;
+    void completeRound(std::vector<Pending>& round, bool requeue);
+    void deadLetter(const Pending& pending);
 
     static size_t WriteCallback(void* contents, size_t size, 
                               size_t nmemb, void* userp);
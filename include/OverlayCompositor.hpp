@@ -0,0 +1,64 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Ekran katmanları. Seyrek değişen çizimler (su ölçeği, menü) kare
+// boyutunda BGRA tuvallere bir kez rasterleştirilir ve anahtarları değişene
+// kadar yeniden çizilmez. compose() yalnızca katmanın içerik taşıyan
+// karolarını (kirli dikdörtgenler) alfa ile görüntü karesine karıştırır;
+// tespit her zaman temiz kare üzerinde çalışır. Headless modda hiçbir şey
+// rasterleştirilmez ya da karıştırılmaz. Kareye yayılan ince çizimler (grid)
+// her karoyu kirletir; onlar doğrudan kareye çizilmelidir.
+class OverlayCompositor {
+public:
+    using Renderer = std::function<void(cv::Mat& canvas)>;
+
+    struct Stats {
+        uint64_t rasterized = 0;   // Yeniden çizilen katman sayısı
+        uint64_t composed = 0;     // Karıştırılan karo sayısı
+    };
+
+    OverlayCompositor();
+
+    void setHeadless(bool enable) { headless = enable; }
+    bool isHeadless() const { return headless; }
+
+    // Katmanlar eklenme sırasıyla üst üste biner; dönen kimlik diğer çağrılarda kullanılır
+    int addLayer(const std::string& name);
+    // Anahtar ya da boyut değiştiyse katmanı temizleyip render ile yeniden çizer.
+    // Tuval CV_8UC4'tür; çizim renklerinde alfa (4. bileşen) görünürlüğü belirler.
+    void updateLayer(int layer, uint64_t key, const cv::Size& size, const Renderer& render);
+    void setVisible(int layer, bool visible);
+    void invalidate(int layer);
+
+    // Görünür katmanları BGR kareye karıştırır
+    void compose(cv::Mat& frame);
+    // Tek katmanı karıştırır; dinamik çizimler arasında z-sırasını korumak için
+    void compose(int layer, cv::Mat& frame);
+    Stats getStats() const { return stats; }
+
+    // Boyuttan türetilen anahtar (yalnızca boyuta bağlı katmanlar için)
+    static uint64_t sizeKey(const cv::Size& size, uint64_t revision = 0);
+
+private:
+    static constexpr int TILE_SIZE = 64;
+
+    struct Layer {
+        std::string name;
+        uint64_t key = 0;
+        bool valid = false;
+        bool visible = true;
+        cv::Mat canvas;              // BGRA
+        std::vector<cv::Rect> tiles; // Alfası sıfır olmayan karolar (satır boyunca birleştirilmiş)
+    };
+
+    std::vector<Layer> layers;
+    bool headless;
+    Stats stats;
+
+    static void collectTiles(Layer& layer);
+    static void blend(const cv::Mat& canvas, const cv::Rect& rect, cv::Mat& frame);
+};
\ No newline at end of file
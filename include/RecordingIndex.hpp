@@ -0,0 +1,81 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "TrackingSystem.hpp"
+
+// Kayıt segmentlerinin yan dosyası (<segment>.idx). Yalnızca eklemeli ikili
+// kayıtlar: her kare için zaman damgaları ve anahtar kare bilgisi, ardından
+// o karedeki izler (sınıf, kutu, hız, bölgeler). "Salı günü 2. bölgedeki
+// kişiler" sorgusu yeniden çıkarım yerine idx taraması + kare numarasıyla
+// doğrudan konumlanma olur.
+// Dosya: [başlık] + kayıt*; kayıt = [tip:u8][uzunluk:u16][veri]
+// Yarım yazılmış son kayıt okunurken yok sayılır.
+class RecordingIndex {
+public:
+    struct Header {
+        int32_t fourcc = 0;
+        double fps = 0.0;
+        int32_t width = 0;
+        int32_t height = 0;
+        double startTime = 0.0;   // Segmentin ilk karesinin Unix zamanı
+    };
+
+    struct Query {
+        std::string className;    // Boş: tüm sınıflar
+        int zone = -1;            // -1: bölge koşulu yok
+        double from = 0.0;        // Unix saniye
+        double to = std::numeric_limits<double>::max();
+    };
+
+    struct Hit {
+        std::string videoPath;
+        uint32_t frameIndex;      // CAP_PROP_POS_FRAMES ile konumlanılır
+        uint32_t keyframeIndex;   // Bu kareden önceki son anahtar kare
+        double mediaTime;
+        double wallTime;
+        int trackId;              // İzin görünen ID'si (süreç içinde artan)
+        std::string className;
+        cv::Rect bbox;
+        float speed;
+        std::vector<int> zones;
+    };
+
+    RecordingIndex();
+    ~RecordingIndex();
+
+    RecordingIndex(const RecordingIndex&) = delete;
+    RecordingIndex& operator=(const RecordingIndex&) = delete;
+
+    // Yazıcı
+    bool open(const std::string& path, const Header& header);
+    void appendFrame(uint32_t frameIndex, double mediaTime, double wallTime, bool keyframe);
+    void appendTracks(uint32_t frameIndex, const TrackingSystem::TrackSnapshot& snapshot);
+    bool flush();
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+    // Okuyucu: dizindeki tüm yan dosyaları tarar (zaman sırasıyla)
+    static std::vector<Hit> scan(const std::string& directory, const Query& query);
+    // Videoyu açar ve isabetin karesine konumlanır
+    static bool seek(cv::VideoCapture& capture, const Hit& hit);
+    // Segment yolundan yan dosya yolu (uzantı .idx olur)
+    static std::string sidecarPath(const std::string& videoPath);
+
+private:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+
+    enum RecordType : uint8_t {
+        RECORD_FRAME = 1,
+        RECORD_TRACK = 2
+    };
+
+    int fd;
+    std::string buffer;
+
+    void beginRecord(RecordType type, size_t& lengthOffset);
+    void endRecord(size_t lengthOffset);
+    static void scanFile(const std::string& indexPath, const Query& query, std::vector<Hit>& hits);
+};
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Kararlı anahtarlı, yoğun (dense) depolamalı konteyner.
+// Anahtar = [nesil:11 bit | yuva:20 bit]; silinen yuva yeniden kullanıldığında
+// nesil artar, böylece eski anahtarlar geçersiz kalır. Arama O(1), değerler
+// bitişik bir dizide tutulur ve silme son elemanı boşluğa taşır (swap-remove);
+// paralel SoA dizileri aynı yoğun indeksle eşlenebilir.
+template <typename T>
+class SlotMap {
+public:
+    using Key = int32_t;
+    static constexpr Key INVALID_KEY = -1;
+
+    Key insert(T value) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+
+        slots[slot].dense = static_cast<uint32_t>(values.size());
+        values.push_back(std::move(value));
+        denseSlot.push_back(slot);
+        return makeKey(slot, slots[slot].generation);
+    }
+
+    // Yoğun indeks (-1: anahtar geçersiz)
+    int find(Key key) const {
+        if (key < 0) return -1;
+        uint32_t slot = static_cast<uint32_t>(key) & INDEX_MASK;
+        uint32_t generation = static_cast<uint32_t>(key) >> INDEX_BITS;
+        if (slot >= slots.size() || slots[slot].generation != generation ||
+            slots[slot].dense == FREE) {
+            return -1;
+        }
+        return static_cast<int>(slots[slot].dense);
+    }
+
+    T* get(Key key) {
+        int index = find(key);
+        return index < 0 ? nullptr : &values[index];
+    }
+
+    const T* get(Key key) const {
+        int index = find(key);
+        return index < 0 ? nullptr : &values[index];
+    }
+
+    // Son eleman denseIndex konumuna taşınır
+    void eraseAt(size_t denseIndex) {
+        uint32_t slot = denseSlot[denseIndex];
+        uint32_t lastSlot = denseSlot.back();
+
+        if (denseIndex + 1 != values.size()) {
+            values[denseIndex] = std::move(values.back());
+            denseSlot[denseIndex] = lastSlot;
+            slots[lastSlot].dense = static_cast<uint32_t>(denseIndex);
+        }
+        values.pop_back();
+        denseSlot.pop_back();
+
+        slots[slot].dense = FREE;
+        slots[slot].generation = (slots[slot].generation + 1) & GENERATION_MASK;
+        freeSlots.push_back(slot);
+    }
+
+    bool erase(Key key) {
+        int index = find(key);
+        if (index < 0) return false;
+        eraseAt(static_cast<size_t>(index));
+        return true;
+    }
+
+    void clear() {
+        for (uint32_t slot : denseSlot) {
+            slots[slot].dense = FREE;
+            slots[slot].generation = (slots[slot].generation + 1) & GENERATION_MASK;
+            freeSlots.push_back(slot);
+        }
+        values.clear();
+        denseSlot.clear();
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    Key keyAt(size_t denseIndex) const {
+        uint32_t slot = denseSlot[denseIndex];
+        return makeKey(slot, slots[slot].generation);
+    }
+
+    T& operator[](size_t denseIndex) { return values[denseIndex]; }
+    const T& operator[](size_t denseIndex) const { return values[denseIndex]; }
+
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+private:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << 11) - 1;
+    static constexpr uint32_t FREE = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense;       // values içindeki konum (FREE: boş)
+        uint32_t generation;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<T> values;
+    std::vector<uint32_t> denseSlot;  // Yoğun indeks -> yuva
+
+    static Key makeKey(uint32_t slot, uint32_t generation) {
+        return static_cast<Key>((generation << INDEX_BITS) | slot);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Uyarı anlık görüntülerini arka planda JPEG olarak kodlayıp diske yazar.
+// submit() görüntüyü kopyalamaz: cv::Mat başlığı (referans sayacı) kuyruğa
+// girer, dosya yolu hemen döner. Kuyrukta tutulan tamponların toplamı bellek
+// bütçesiyle sınırlıdır; bütçe doluysa görüntü alınmaz (boş yol döner).
+// Çağıran, kuyruğa verdiği tampona sonradan yazmamalıdır
+// (bkz. VideoUtils::detachIfShared).
+class SnapshotEncoder {
+public:
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;     // Bellek bütçesi dolu
+        uint64_t failed = 0;      // Kodlama/yazma hatası
+        size_t queuedBytes = 0;
+    };
+
+    explicit SnapshotEncoder(const std::string& directory,
+                             int workerCount = 2,
+                             size_t memoryBudget = 64 * 1024 * 1024,
+                             int jpegQuality = 85);
+    ~SnapshotEncoder();
+
+    SnapshotEncoder(const SnapshotEncoder&) = delete;
+    SnapshotEncoder& operator=(const SnapshotEncoder&) = delete;
+
+    // Görüntüyü kodlama kuyruğuna alır; bağlantı (URL ya da yerel yol) döner
+    std::string submit(const cv::Mat& image, const std::string& prefix);
+    // Dosyalar bir HTTP sunucusundan yayınlanıyorsa bağlantı öneki
+    void setPublicBaseUrl(const std::string& url);
+    Stats getStats();
+
+    // Bölgenin çevresiyle birlikte kırpıntısı (ROI, kopya yok; dışarıdaysa boş)
+    static cv::Mat contextCrop(const cv::Mat& frame, const cv::Rect& region);
+
+private:
+    struct Job {
+        cv::Mat image;
+        std::string path;
+        size_t bytes;
+    };
+
+    std::string directory;
+    std::string publicBaseUrl;
+    size_t memoryBudget;
+    int jpegQuality;
+
+    std::deque<Job> jobs;
+    std::mutex jobMutex;
+    std::condition_variable jobCondition;
+    bool stopRequested;
+    Stats stats;                       // jobMutex ile korunur
+    std::atomic<uint64_t> nextSequence;
+    std::vector<std::thread> workers;
+
+    static size_t retainedBytes(const cv::Mat& image);
+    void workerLoop();
+    bool writeJpeg(const Job& job, std::vector<uchar>& buffer, const std::vector<int>& params);
+};
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// İz-tespit eşleştirmesi.
+// 1) Tespitler uniform bir ızgaraya yerleştirilir; her iz yalnızca kutusunun
+//    kapsadığı hücrelerdeki tespitlerle karşılaştırılır (IoU > 0 için örtüşme şart).
+// 2) Aday çiftlerin IoU değerleri SoA dizileri üzerinde toplu hesaplanır.
+// 3) Aday grafiği bağlı bileşenlere ayrılır ve her bileşen Hungarian
+//    (Kuhn-Munkres) algoritmasıyla optimal olarak çözülür.
+class TrackAssociation {
+public:
+    struct Candidate {
+        int track;      // İz indeksi
+        int detection;  // Tespit indeksi
+        float iou;      // Kesişim/birleşim oranı
+    };
+
+    // Her iz için eşleşen tespit indeksi (-1: eşleşme yok)
+    static std::vector<int> associate(const std::vector<cv::Rect>& trackBoxes,
+                                      const std::vector<cv::Rect>& detectionBoxes,
+                                      float minIOU);
+
+    // Izgara ile ön elenmiş, minIOU eşiğini geçen aday çiftler
+    static std::vector<Candidate> findCandidates(const std::vector<cv::Rect>& trackBoxes,
+                                                 const std::vector<cv::Rect>& detectionBoxes,
+                                                 float minIOU);
+
+    // Yoğun maliyet matrisi (rows x cols, satır öncelikli) için minimum maliyetli atama.
+    // Her satır için atanan sütun (-1: atanmadı)
+    static std::vector<int> solveAssignment(const std::vector<float>& cost,
+                                            int rows, int cols);
+
+    // Tek kutuya karşı n kutunun IoU değeri (SoA girişi, vektörleşebilir döngü)
+    static void computeIOU(const cv::Rect& box,
+                           const float* x1, const float* y1,
+                           const float* x2, const float* y2,
+                           int count, float* out);
+
+private:
+    // Tespitlerin hücrelere dağıtıldığı sıkıştırılmış (CSR) ızgara
+    class SpatialGrid {
+    public:
+        SpatialGrid(const std::vector<cv::Rect>& boxes);
+        template <typename Fn>
+        void query(const cv::Rect& box, Fn&& fn) const;
+
+    private:
+        cv::Rect bounds;
+        int cellSize;
+        int gridCols;
+        int gridRows;
+        std::vector<int> cellStart;
+        std::vector<int> cellItems;
+
+        cv::Rect cellRange(const cv::Rect& box) const;
+    };
+};
\ No newline at end of file
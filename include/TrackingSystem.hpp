@@ -1,76 +1,118 @@
 #pragma once
 #include <opencv2/opencv.hpp>
-#include <opencv2/face.hpp>
 #include <chrono>
 #include <vector>
 #include <map>
+#include <memory>
 #include "Detection.hpp"
-#include "NotificationSystem.hpp"
+#include "FaceGallery.hpp"
+#include "FrameClock.hpp"
+#include "KalmanBank.hpp"
+#include "SlotMap.hpp"
+#include "TrajectoryBuffer.hpp"
+#include "ZoneIndex.hpp"
+#include "EventBus.hpp"
+#include "SnapshotEncoder.hpp"
 
 class TrackingSystem {
 public:
     struct TrackedObject {
-        int id;                 // Benzersiz iz ID'si
+        int id;                 // SlotMap anahtarı (iç arama; nesil taşabilir)
+        int displayId;          // Kullanıcıya görünen ID (süreç boyunca artan)
         cv::Rect bbox;          // Nesne kutusu
         std::string className;  // Nesne sınıfı
         float speed;            // Hız (m/s)
         float direction;        // Hareket yönü (radyan)
-        std::vector<cv::Point> trajectory; // Hareket yörüngesi
+        TrajectoryBuffer trajectory;  // Hareket yörüngesi (sınırlı bellek)
         cv::Mat face;          // Yüz görüntüsü
         std::string recognizedPerson; // Tanınan kişi adı
         bool isInRestrictedZone;      // Yasak bölgede mi?
+        std::vector<int> zones;       // İçinde bulunduğu bölgeler (sıralı indeks)
+        std::vector<int> approachingZones; // Erken uyarı verilmiş bölgeler (sıralı)
         bool isMoving;               // Hareket ediyor mu?
-        std::chrono::steady_clock::time_point lastSeen; // Son görülme zamanı
-        std::chrono::steady_clock::time_point lastMoved; // Son hareket zamanı
-        bool violationReported;      // İhlal bildirimi yapıldı mı?
+        MediaTime lastSeen;          // Son görülme zamanı (medya zamanı)
+        MediaTime lastMoved;         // Son hareket zamanı (medya zamanı)
+        int missedFrames;            // Art arda eşleşmeyen kare sayısı (0: bu karede görüldü)
         bool nightActivityReported;  // Gece aktivitesi bildirimi yapıldı mı?
         bool stationaryReported;     // Durağan nesne bildirimi yapıldı mı?
         
-        TrackedObject() : id(-1), speed(0), direction(0), isInRestrictedZone(false), 
-                         isMoving(false), violationReported(false),
+        TrackedObject() : id(-1), displayId(-1), speed(0), direction(0), isInRestrictedZone(false), 
+                         isMoving(false), missedFrames(0),
                          nightActivityReported(false), stationaryReported(false) {}
     };
 
+    // Kare başına bir kez yayımlanan değişmez iz görüntüsü. Okuyucular (çizim,
+    // API) paylaşılan işaretçiyi alır; izleyiciyi bekletmez, kopyalamaz.
+    struct TrackSnapshot {
+        MediaTime timestamp;           // Karenin medya zamanı
+        uint64_t frameNumber = 0;      // Yayın sırası
+        std::vector<TrackedObject> tracks;
+    };
+    using TrackSnapshotPtr = std::shared_ptr<const TrackSnapshot>;
+
     TrackingSystem();
     
-    void updateTracks(const std::vector<Detection>& detections,
-                     const cv::Mat& frame);
+    // Tespitleri izlerle eşleştirir ve trackId (displayId)/hız/yön alanlarını doldurur
+    void updateTracks(std::vector<Detection>& detections,
+                     const cv::Mat& frame,
+                     MediaTime timestamp);
     void enableNightVision(bool enable);
     cv::Mat enhanceNightVision(const cv::Mat& frame);
     
-    std::vector<TrackedObject> getTracks() const;
-    void drawTrajectories(cv::Mat& frame);
+    // Son yayımlanan görüntü; herhangi bir iş parçacığından çağrılabilir
+    TrackSnapshotPtr getTracks() const;
+    void drawTrajectories(cv::Mat& frame) const;
     void removeStaleTracts();
     
     void addRestrictedZone(const cv::Rect& zone);
+    void addRestrictedZone(const std::vector<cv::Point>& polygon,
+                          const std::string& name = "");
     void clearRestrictedZones();
     void setMotionThresholds(double maxVelocity, double minMovement);
+    // Erken uyarı için ileri bakış süresi (saniye, 0: kapalı)
+    void setPredictionHorizon(double seconds);
+    void setFaceGallery(std::shared_ptr<FaceGallery> gallery);
+    // İz ve bölge olaylarının yayımlandığı veriyolu (nullptr: olay yok)
+    void setEventBus(std::shared_ptr<EventBus> bus);
     
     std::vector<cv::Point> predictTrajectory(const TrackedObject& track, 
                                            int frames = 30);
 
 private:
-    std::vector<TrackedObject> tracks;
-    std::vector<cv::Rect> restrictedZones;
-    NotificationSystem notificationSystem;
-    cv::Ptr<cv::face::FaceRecognizer> faceRecognizer;
-    std::map<int, std::string> knownFaces;
+    SlotMap<TrackedObject> tracks;  // Anahtar = iz ID'si
+    KalmanBank motionFilter;  // tracks ile aynı (yoğun) indeksleme
+    TrackSnapshotPtr publishedSnapshot;          // atomic_load/atomic_store ile erişilir
+    std::shared_ptr<TrackSnapshot> spareSnapshot; // Bir önceki görüntü, yeniden kullanım için
+    ZoneIndex restrictedZones;
+    std::shared_ptr<FaceGallery> faceGallery;
+    std::shared_ptr<EventBus> eventBus;
+    cv::Mat currentFrame;        // updateTracks süresince işlenen kare (yalnızca referans)
     
     bool nightVisionEnabled;
-    int nextTrackId;
+    uint64_t publishedFrames;
+    int nextDisplayId;
     float deltaTime;
+    MediaTime currentTime;       // Son işlenen karenin medya zamanı
+    bool hasLastUpdate;
     
     // Sabitler ve eşik değerleri
     double MAX_ALLOWED_VELOCITY = 5.0;    // m/s
     double MIN_MOVEMENT_THRESHOLD = 5.0;   // piksel
-    const int MAX_TRACK_AGE = 30;         // frame
+    double PREDICTION_HORIZON = 5.0;      // saniye
+    const float IOU_THRESHOLD = 0.3f;     // Eşleştirme için minimum IoU
+    const float MIN_DELTA_TIME = 0.001f;  // saniye
+    const float MAX_DELTA_TIME = 1.0f;    // saniye
+    const int MAX_TRACK_AGE = 30;         // saniye
+    const int MAX_MISSED_FRAMES = 5;      // Bundan sonra eşleşmeyen iz tahminle ilerlemez
     const int MAX_STATIONARY_TIME = 300;  // saniye
     const double PIXEL_TO_METER_RATIO = 0.01; // piksel başına metre
     
-    bool isInRestrictedZone(const cv::Point& point);
+    void updateZoneMembership();
+    void checkPredictedIntrusions();
     void checkSecurityViolations();
-    double calculateIOU(const cv::Rect& box1, const cv::Rect& box2);
-    void processFaceRecognition(TrackedObject& track);
+    void publishEvent(EventBus::Payload payload, int priority,
+                      const TrackedObject* track = nullptr, bool attachSnapshot = false);
+    void processFaceRecognition(TrackedObject& track, const std::string& knownName);
     void updateTrackVelocities();
-    std::string getCurrentTimestamp();
+    void publishSnapshot();
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Uzun ömürlü izler için sınırlı bellekli yörünge.
+// Son RECENT_CAPACITY nokta sabit kapasiteli bir halka tamponda tam çözünürlükte
+// tutulur. Halkadan düşen noktalar çevrimiçi sadeleştirilerek (mesafe eşiği +
+// doğrusallık) uzun dönem çoklu çizgiye eklenir; bu çizgi HISTORY_CAPACITY'yi
+// aşarsa toleransı artırılarak Douglas-Peucker ile yeniden sadeleştirilir.
+// Çevrimiçi eşik sabittir; Douglas-Peucker toleransı her sadeleştirmede
+// baştan başlar, böylece uzun ömürlü izde yeni noktalar kabul edilmeye devam eder.
+// Son segmente katılan noktalar (en çok MAX_ABSORBED) segment her uzadığında
+// yeniden denetlenir: eğride sapma birikmez.
+// İz başına bellek (RECENT_CAPACITY + HISTORY_CAPACITY) noktayla sınırlıdır.
+class TrajectoryBuffer {
+public:
+    static constexpr size_t RECENT_CAPACITY = 64;
+    static constexpr size_t HISTORY_CAPACITY = 128;
+    static constexpr size_t MAX_ABSORBED = 16;
+
+    TrajectoryBuffer();
+
+    void push(const cv::Point& point);
+    void push_back(const cv::Point& point) { push(point); }
+    void clear();
+
+    // Eskiden yeniye: önce uzun dönem çizgi, sonra son noktalar
+    size_t size() const { return history.size() + recentCount; }
+    bool empty() const { return size() == 0; }
+    const cv::Point& operator[](size_t index) const;
+    const cv::Point& back() const;
+
+    size_t recentSize() const { return recentCount; }
+    const std::vector<cv::Point>& longTerm() const { return history; }
+    std::vector<cv::Point> points() const;
+    uint64_t totalPoints() const { return pushedCount; }
+
+private:
+    std::array<cv::Point, RECENT_CAPACITY> recent;
+    size_t recentHead;   // En eski noktanın indeksi
+    size_t recentCount;
+
+    std::vector<cv::Point> history;
+    std::array<cv::Point, MAX_ABSORBED> absorbed;  // Son segmente katılan noktalar
+    size_t absorbedCount;
+    uint64_t pushedCount;
+
+    void appendHistory(const cv::Point& point);
+    void simplifyHistory();
+};
\ No newline at end of file
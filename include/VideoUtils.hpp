@@ -16,6 +16,14 @@ public:
         double duration;        // Video süresi (saniye)
     };
 
+    // Kayıt kodeği: MJPG düşük CPU / büyük dosya, XVID ve H264 küçük dosya / yüksek CPU
+    enum class Codec {
+        PLATFORM_DEFAULT,
+        MJPG,
+        XVID,
+        H264
+    };
+
     // Kayıt yapılandırma yapısı
     struct RecordingConfig {
         std::string filename;   // Kayıt dosya adı
@@ -23,6 +31,10 @@ public:
         int height;            // Kayıt yüksekliği
         double fps;            // Kayıt FPS
         bool isColor;          // Renkli mi?
+        Codec codec = Codec::PLATFORM_DEFAULT;
+        double segmentSeconds = 0.0;  // > 0: kayıt bu süreli segmentlere bölünür
+        double idleFps = 0.0;         // > 0: hareketli iz yokken kayıt hızı (zaman atlamalı)
+        double activityHold = 10.0;   // Son hareketten sonra tam hızda kalma süresi (sn)
     };
 
     // Oynatma kontrol yapısı
@@ -35,6 +47,10 @@ public:
     // Video/Kamera işlemleri
     static cv::VideoCapture openVideo(const std::string& source);
     static cv::VideoWriter createVideoWriter(const RecordingConfig& config);
+    // Yazıcının beklediği kare boyutu (çözünürlük sınırları uygulanmış)
+    static cv::Size recordingSize(const RecordingConfig& config);
+    static int codecFourcc(Codec codec);
+    static std::string codecExtension(Codec codec);  // ".avi", ".mp4"
     static VideoInfo getVideoInfo(const cv::VideoCapture& cap);
     
     // Kare işleme
@@ -57,6 +73,9 @@ public:
     
     // Dosya işlemleri
     static void saveFrame(const cv::Mat& frame, const std::string& filename);
+    // Tampon başka yerde tutuluyorsa (ör. kodlama kuyruğu) bırakılır; sonraki
+    // yazma yeni tampon ayırır ve tutulan görüntü değişmez
+    static void detachIfShared(cv::Mat& frame);
     static bool isVideoFile(const std::string& source);
     static std::string getTimeStamp();
     static std::string generateFilename(const std::string& prefix);
@@ -1,26 +1,69 @@
 #pragma once
 #include <opencv2/opencv.hpp>
+#include <array>
 #include <chrono>
+#include <memory>
+#include "EventBus.hpp"
+#include "FrameClock.hpp"
+#include "WaterLevelHistory.hpp"
+#include "WaterlineEstimator.hpp"
 
+// Su seviyesi dakikalar içinde değişir: ölçüm her karede değil, ayarlanabilir
+// aralıkla (varsayılan 1 sn medya zamanı) yapılır. Ham örnekler kayan medyan ile
+// aykırı değerlerden, ardından zaman sabitli EMA ile gürültüden arındırılır;
+// yükselme hızı da aynı şekilde yumuşatılır. Tüm tüketiciler (çizim, tespit
+// döngüsü, olaylar) önbellekteki sonucu kullanır. Ham ölçüm WaterlineEstimator
+// ile yapılır: 0. gösterge referans çizgisidir, ek göstergeler addGauge ile
+// eklenir ve gaugeLevels'ta raporlanır. Medyan örnekler WaterLevelHistory'ye
+// yazılır; eğilimden uyarı/kritik seviyeye kalan süre kestirilir.
 class WaterLevelDetector {
 public:
     struct WaterLevelInfo {
-        float currentLevel;     // Mevcut su seviyesi (yüzde olarak)
-        float warningLevel;     // Uyarı seviyesi
-        float criticalLevel;    // Kritik seviye
-        cv::Point measurePoint; // Ölçüm noktası
+        float currentLevel = 0;     // Mevcut su seviyesi (yüzde, yumuşatılmış)
+        float warningLevel = 0;     // Uyarı seviyesi
+        float criticalLevel = 0;    // Kritik seviye
+        cv::Point measurePoint;     // Ölçüm noktası
+        float rawLevel = 0;         // Son ham ölçüm (yüzde)
+        float riseRate = 0;         // Yükselme hızı (yüzde/dakika, düşüşte negatif)
+        MediaTime timestamp{0};     // Son ölçümün medya zamanı
+        bool valid = false;         // En az bir ölçüm yapıldı mı?
+        std::vector<float> gaugeLevels;  // Gösterge başına ham seviye (geçersizse -1)
+        float trendRate = 0;        // Sağlam doğru uydurmasından eğim (yüzde/dakika)
+        double timeToWarning = -1;  // Uyarı seviyesine kalan süre (sn; -1: beklenmiyor)
+        double timeToCritical = -1; // Kritik seviyeye kalan süre (sn; -1: beklenmiyor)
     };
 
     WaterLevelDetector();
     
-    // Mevcut metodlar
+    // Kare başına bir kez çağrılır; ölçüm aralığı dolmadıysa yalnızca önbelleği döner
+    const WaterLevelInfo& update(const cv::Mat& frame, MediaTime timestamp);
+    const WaterLevelInfo& current() const { return latest; }
+    void setSampleInterval(double seconds);
+    void setSmoothing(double levelSeconds, double rateSeconds);
+    // Uyarı/kritik eşik geçişleri veriyoluna yayımlanır (nullptr: kapalı)
+    void setEventBus(std::shared_ptr<EventBus> bus);
+    // Zaman serisini dosyaya eşler (yeniden başlatmada korunur). Kovalar duvar
+    // saatiyle anahtarlanır: yalnızca canlı kaynakta kullanılmalı; dosya
+    // oynatması kayıt hızında ilerleyip geleceğe tarihli kova yazabilir
+    bool enableHistory(const std::string& path);
+    const WaterLevelHistory& getHistory() const { return history; }
+    void setTrendWindow(double seconds);
+    
+    // Anlık (yumuşatılmamış) ölçüm
     WaterLevelInfo detectWaterLevel(const cv::Mat& frame);
     void drawWaterLevel(cv::Mat& frame, const WaterLevelInfo& info);
     void setReferencePoints(const cv::Point& top, const cv::Point& bottom);
+    // Ek gösterge (ör. ikinci eşel); dizini döner
+    int addGauge(const std::string& name, const cv::Point& top, const cv::Point& bottom,
+                 float bandWidth = 10.0f);
+    WaterlineEstimator& getEstimator() { return estimator; }
     void setThresholds(float warning, float critical);
     
     // Yeni eklenen metodlar
-    void drawLiveWaterLevel(cv::Mat& frame);
+    // drawScale false ise tank/ölçek çizilmez (OverlayCompositor katmanından gelir)
+    void drawLiveWaterLevel(cv::Mat& frame, bool drawScale = true);
+    // Kare boyutuna bağlı sabit kısım: tank çerçevesi, ölçek ve etiketler
+    void drawWaterScale(cv::Mat& canvas) const;
     void updateWaterAnimation();
 
 private:
@@ -36,5 +79,26 @@ private:
     std::vector<float> waveOffsets;
     std::chrono::steady_clock::time_point lastUpdateTime;
     
+    // Zamansal filtre
+    static constexpr int MEDIAN_WINDOW = 5;
+    static constexpr float THRESHOLD_HYSTERESIS = 2.0f;  // yüzde
+    double sampleInterval;       // saniye
+    double levelSmoothing;       // EMA zaman sabiti (saniye)
+    double rateSmoothing;        // Hız EMA zaman sabiti (saniye)
+    std::array<float, MEDIAN_WINDOW> samples;
+    int sampleCount;
+    int sampleIndex;
+    WaterLevelInfo latest;
+    int alarmState;              // 0: normal, 1: uyarı, 2: kritik
+    std::shared_ptr<EventBus> eventBus;
+    WaterlineEstimator estimator;  // 0. gösterge: referans çizgisi
+    WaterLevelHistory history;
+    double trendWindow;            // Eğilim penceresi (saniye)
+    double wallOrigin;             // Unix zamanı = wallOrigin + medya zamanı
+    bool hasWallOrigin;
+    
+    static cv::Rect tankArea(const cv::Size& size);
     float calculateWaterLevel(const cv::Mat& frame);
+    cv::Point measurePointFor(float level) const;
+    void publishThresholdChange(float level);
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Su seviyesi zaman serisi. Üç çözünürlükte sabit boyutlu halka tampon tutar
+// (1 sn / 1 dk / 1 sa); her örnek üç halkada da son kovaya katılır ya da yeni
+// kova açar, yani örnek başına maliyet ve toplam bellek sabittir. Halkalar
+// bellek eşlemeli (mmap) bir dosyada durur; yeniden başlatmada geçmiş korunur.
+// Dosya açılamazsa aynı düzen yalnızca bellekte çalışır.
+// Eğilim: pencereye zaman damgasıyla düşen kovalardan, pencereyi kapsayan en
+// ince halkada en çok MAX_TREND_POINTS kova seçilir ve Theil-Sen (ikili eğimlerin medyanı) ile doğru uydurulur; tek
+// tük yansıma/dalga sıçramaları eğimi saptırmaz.
+// İş parçacığı güvenli değildir; sahibi (WaterLevelDetector) tek iş parçacığında kullanır.
+class WaterLevelHistory {
+public:
+    enum class Resolution { SECOND = 0, MINUTE = 1, HOUR = 2 };
+
+    struct Sample {
+        int64_t time;      // Kova başlangıcı (Unix saniye)
+        float mean;
+        float minimum;
+        float maximum;
+        uint32_t count;    // Kovaya katılan ham örnek sayısı
+    };
+
+    struct Trend {
+        bool valid = false;
+        float rate = 0;              // Yüzde/dakika
+        float level = 0;             // Uydurulan doğrunun şimdiki değeri
+        double timeToWarning = -1;   // Saniye; -1: yükselmiyor ya da zaten üstünde
+        double timeToCritical = -1;
+        int points = 0;
+    };
+
+    WaterLevelHistory();
+    ~WaterLevelHistory();
+
+    WaterLevelHistory(const WaterLevelHistory&) = delete;
+    WaterLevelHistory& operator=(const WaterLevelHistory&) = delete;
+
+    // Dosyayı eşler; uyumsuz/bozuk başlıkta dosya sıfırlanır, duvar saatinin
+    // ilerisine tarihli son kovalar atılır
+    bool open(const std::string& path);
+    void close();
+    bool isPersistent() const { return mapped != nullptr; }
+
+    // time: Unix saniye. Son kovadan eski örnekler yok sayılır.
+    void append(double time, float level);
+
+    size_t size(Resolution resolution) const;
+    Sample latest(Resolution resolution) const;
+    // [from, to] aralığındaki kovalar (eskiden yeniye)
+    std::vector<Sample> query(Resolution resolution, double from, double to) const;
+    // Son windowSeconds içindeki eğilim ve eşiklere kalan süre
+    Trend trend(double now, double windowSeconds, float warning, float critical) const;
+
+private:
+    static constexpr int RING_COUNT = 3;
+    static constexpr int MIN_TREND_POINTS = 10;
+    static constexpr int MAX_TREND_POINTS = 60;
+    static constexpr double MIN_TREND_COVERAGE = 0.5;  // Pencerenin en az yarısı
+    static constexpr uint32_t MAGIC = 0x484C5746;  // "FWLH"
+    static constexpr uint32_t VERSION = 1;
+
+    struct RingHeader {
+        uint32_t capacity;
+        uint32_t resolution;  // Kova süresi (saniye)
+        uint64_t written;     // Toplam yazılan kova (son kova: written - 1)
+    };
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t ringCount;
+        uint32_t reserved;
+        RingHeader rings[RING_COUNT];
+    };
+
+    // 6 sa saniyelik, 14 gün dakikalık, 2 yıl saatlik (~1.4 MB)
+    static const RingHeader LAYOUT[RING_COUNT];
+
+    void* mapped;                 // mmap bölgesi (nullptr: bellek içi)
+    size_t mappedSize;
+    int fd;
+    std::vector<char> memory;     // Dosyasız çalışma
+    FileHeader* header;
+    Sample* records[RING_COUNT];
+
+    static size_t storageSize();
+    void attach(char* base, bool initialize);
+    const Sample& at(int ring, uint64_t sequence) const;
+    // time + resolution > from olan ilk kovanın sıra numarası
+    uint64_t lowerBound(int ring, double from) const;
+    void dropFutureBuckets(double now);
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+// Çok göstergeli su çizgisi kestirimi. Her gösterge (eşel, savak kenarı) bir
+// doğru parçasıdır (üst -> alt). Gösterge bölgesi küçültülmüş gri düzleme
+// alınır, parça boyunca bant genişliğinde örneklenir (remap + satır ortalaması)
+// ve profil üzerinde iki seviyeli basamak uydurulur: önek toplamlarıyla tüm
+// bölme noktaları O(n)'de denenir, sınıflar arası farkı en büyük olan nokta su
+// çizgisidir. Tek eşikli sayımdan farklı olarak yerel parlamalar sonucu
+// kaydırmaz. Göstergeler paralel işlenir; bölge pikselleri önceki ölçümden
+// changeThreshold'dan az değiştiyse önceki sonuç korunur.
+class WaterlineEstimator {
+public:
+    struct Gauge {
+        std::string name;
+        cv::Point2f top;         // Göstergenin üst ucu (tam çözünürlük)
+        cv::Point2f bottom;      // Göstergenin alt ucu
+        float bandWidth = 10.0f; // Parçaya dik örnekleme bandı (piksel)
+    };
+
+    struct Reading {
+        float level = 0;         // Yüzde (alt uç 0, üst uç 100)
+        float contrast = 0;      // Su/kuru kısım gri farkı (güven ölçüsü)
+        cv::Point2f waterline;   // Su çizgisinin görüntüdeki yeri
+        bool valid = false;
+        bool recomputed = false; // Son estimate() çağrısında yeniden hesaplandı mı?
+    };
+
+    WaterlineEstimator();
+
+    int addGauge(const Gauge& gauge);
+    void setGauge(int index, const Gauge& gauge);
+    void clearGauges();
+    size_t gaugeCount() const { return gauges.size(); }
+    const Gauge& gauge(int index) const { return gauges[index].gauge; }
+
+    void setDownscale(int factor);
+    // Gri seviye ortalama mutlak fark; altındaki değişimlerde yeniden hesap yok
+    void setChangeThreshold(double meanAbsDiff);
+
+    // Tüm göstergeleri ölçer (paralel)
+    void estimate(const cv::Mat& frame);
+    const Reading& reading(int index) const { return gauges[index].reading; }
+
+private:
+    static constexpr float MIN_CONTRAST = 8.0f;  // Daha düşük farkta su çizgisi belirsiz
+    static constexpr int MIN_SAMPLES = 8;
+
+    struct State {
+        Gauge gauge;
+        cv::Size frameSize;      // Eşlemelerin hazırlandığı kare boyutu
+        cv::Rect roi;            // Tam çözünürlükte bölge
+        cv::Mat mapX, mapY;      // Küçük bölgede örnekleme eşlemeleri (n x bant)
+        cv::Mat small;           // Küçültülmüş bölge (BGR)
+        cv::Mat gray;            // Küçültülmüş gri bölge
+        cv::Mat previousGray;    // Son hesaplamadaki gri bölge
+        cv::Mat samples, profile;
+        std::vector<double> prefix, prefixSquares;
+        Reading reading;
+    };
+
+    std::vector<State> gauges;
+    int downscale;
+    double changeThreshold;
+
+    void prepare(State& state, const cv::Size& frameSize) const;
+    void estimateGauge(State& state, const cv::Mat& frame) const;
+    static bool fitStep(const float* profile, int count, std::vector<double>& prefix,
+                        int& split, float& contrast);
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+// Çokgen yasak bölgeler için uzamsal indeks.
+// Bölge sınır kutuları uniform bir ızgaraya (CSR) yerleştirilir; toplu sorguda
+// her nokta yalnızca kendi hücresindeki bölgelerle eşleştirilir. Aday noktalar
+// bölge başına gruplanır ve ışın kesişim (crossing-number) testi kenarlar
+// dışta, noktalar içte olacak şekilde SoA dizileri üzerinde yapılır.
+// Doğru parçası sorguları (öngörülen yörüngeler) aynı gruplama ile kenar-parça
+// kesişim testine girer.
+class ZoneIndex {
+public:
+    struct Zone {
+        std::string name;
+        cv::Rect bounds;     // Çokgenin sınır kutusu
+        int vertexStart;     // xs/ys içindeki ilk köşe
+        int vertexCount;
+    };
+
+    struct Hit {
+        int point;  // Sorgu noktası indeksi
+        int zone;   // Bölge indeksi
+    };
+
+    struct SegmentHit {
+        int segment;  // Sorgu parçası indeksi
+        int zone;     // Bölge indeksi
+        float t;      // Parça boyunca ilk sınır kesişimi [0, 1]
+    };
+
+    ZoneIndex();
+
+    // Bölge indeksi döner; 3'ten az köşeli çokgenler reddedilir (-1)
+    int addZone(const std::vector<cv::Point>& polygon, const std::string& name = "");
+    void clear();
+
+    size_t size() const { return zones.size(); }
+    bool empty() const { return zones.empty(); }
+    const Zone& zone(int index) const { return zones[index]; }
+    std::vector<cv::Point> polygon(int index) const;
+
+    // Tüm noktalar için içinde bulunulan bölgeler; sonuç (nokta, bölge) sıralı
+    void containsBatch(const std::vector<cv::Point2f>& points, std::vector<Hit>& hits) const;
+    bool contains(const cv::Point2f& point) const;
+
+    // starts[i] -> ends[i] parçalarının kestiği bölge sınırları; sonuç (parça, bölge) sıralı
+    void intersectsBatch(const std::vector<cv::Point2f>& starts,
+                         const std::vector<cv::Point2f>& ends,
+                         std::vector<SegmentHit>& hits) const;
+
+private:
+    std::vector<Zone> zones;
+    std::vector<float> xs, ys;  // Tüm bölgelerin köşeleri, bölge sırasıyla
+
+    // Bölge sınır kutularının ızgarası
+    cv::Rect gridBounds;
+    int cellSize;
+    int gridCols;
+    int gridRows;
+    std::vector<int> cellStart;
+    std::vector<int> cellZones;
+
+    void rebuildGrid();
+    int cellOf(const cv::Point2f& point) const;
+    // Bölgenin kenarlarına karşı n noktanın içerik testi (inside: 0/1)
+    void testZone(const Zone& zone, const float* px, const float* py,
+                  int count, unsigned char* inside) const;
+    // Bölgenin kenarlarına karşı n parçanın ilk kesişim parametresi (yoksa > 1)
+    void crossZone(const Zone& zone, const float* ax, const float* ay,
+                   const float* bx, const float* by, int count, float* firstT) const;
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "AlertCoalescer.hpp"
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+AlertCoalescer::AlertCoalescer() : suppressedCount(0) {
+}
+
+void AlertCoalescer::setPolicy(const Policy& newPolicy) {
+    policy = newPolicy;
+    buckets.clear();
+}
+
+double AlertCoalescer::seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+bool AlertCoalescer::takeToken(int type, Clock::time_point now) {
+    Bucket& bucket = buckets[type];
+    if (!bucket.initialized) {
+        bucket.tokens = policy.burst;
+        bucket.lastRefill = now;
+        bucket.initialized = true;
+    }
+
+    double refill = seconds(now - bucket.lastRefill) * policy.ratePerMinute / 60.0;
+    bucket.tokens = std::min(policy.burst, bucket.tokens + refill);
+    bucket.lastRefill = now;
+
+    if (bucket.tokens < 1.0) return false;
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+bool AlertCoalescer::admit(const Event& event, Clock::time_point now) {
+    // Anahtar verilmediyse aynı metin aynı olay sayılır
+    std::string id = std::to_string(event.type) + ":" +
+                     (event.key.empty() ? event.message : event.key);
+    KeyState& state = keys[id];
+
+    bool inWindow = state.forwarded &&
+                    seconds(now - state.lastForwarded) < policy.suppressionWindow;
+    bool allowed = !inWindow &&
+                   (event.priority >= policy.bypassPriority || takeToken(event.type, now));
+
+    if (allowed) {
+        state.forwarded = true;
+        state.lastForwarded = now;
+        return true;
+    }
+
+    if (state.suppressed == 0) {
+        state.firstSuppressed = now;
+        state.maxPriority = 0;
+    }
+    state.suppressed++;
+    state.maxPriority = std::max(state.maxPriority, event.priority);
+    state.latest = event;
+    suppressedCount++;
+    return false;
+}
+
+void AlertCoalescer::collectSummaries(Clock::time_point now, std::vector<Event>& out, bool force) {
+    for (auto it = keys.begin(); it != keys.end();) {
+        KeyState& state = it->second;
+
+        if (state.suppressed > 0) {
+            double elapsed = seconds(now - state.firstSuppressed);
+            if (force || elapsed >= policy.summaryInterval) {
+                std::stringstream ss;
+                ss << state.latest.message << " (+" << state.suppressed
+                   << " more events in last " << static_cast<int>(elapsed + 0.5) << "s)";
+
+                Event summary = state.latest;
+                summary.message = ss.str();
+                summary.priority = state.maxPriority;
+                out.push_back(std::move(summary));
+
+                state.suppressed = 0;
+            }
+        }
+
+        // Pencere dolmuş ve bekleyen özeti olmayan anahtarlar unutulur
+        bool idle = state.suppressed == 0 &&
+                    (!state.forwarded ||
+                     seconds(now - state.lastForwarded) >= policy.suppressionWindow);
+        it = idle ? keys.erase(it) : std::next(it);
+    }
+}
+
+void AlertCoalescer::clear() {
+    keys.clear();
+    buckets.clear();
+}
\ No newline at end of file
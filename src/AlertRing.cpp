@@ -0,0 +1,119 @@
+#include "AlertRing.hpp"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+void copyText(char* destination, size_t size, const std::string& text) {
+    size_t length = std::min(text.size(), size - 1);
+    std::memcpy(destination, text.data(), length);
+    destination[length] = '\0';
+}
+}
+
+AlertRing::AlertRing(size_t capacity)
+    : slotCount(std::max<size_t>(1, capacity)), slots(new Slot[slotCount]),
+      head(0), clearedThrough(0) {
+    for (size_t i = 0; i < slotCount; i++) {
+        for (auto& word : slots[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+AlertRing::AlertRing(size_t capacity, const AlertRing& previous)
+    : AlertRing(capacity) {
+    // En yeniler toplanır, eskiden yeniye yeniden yazılır
+    std::vector<Entry> recent;
+    recent.reserve(slotCount);
+    previous.visit([&recent](const Entry& entry) { recent.push_back(entry); }, slotCount);
+    
+    for (auto it = recent.rbegin(); it != recent.rend(); ++it) {
+        uint64_t sequence = head.fetch_add(1, std::memory_order_relaxed) + 1;
+        Entry entry = *it;
+        entry.sequence = sequence;
+        write(sequence, entry);
+    }
+}
+
+const char* AlertRing::formatTimestamp(std::chrono::system_clock::time_point time) {
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cached[TIMESTAMP_SIZE];
+    
+    std::time_t second = std::chrono::system_clock::to_time_t(time);
+    if (second != cachedSecond) {
+        std::tm local;
+        localtime_r(&second, &local);
+        std::strftime(cached, sizeof(cached), "%Y-%m-%d %H:%M:%S", &local);
+        cachedSecond = second;
+    }
+    return cached;
+}
+
+uint64_t AlertRing::push(const std::string& message, int priority,
+                         const cv::Point& location, const std::string& imageUrl,
+                         std::chrono::system_clock::time_point time) {
+    Entry entry;
+    entry.priority = priority;
+    entry.x = location.x;
+    entry.y = location.y;
+    std::memcpy(entry.timestamp, formatTimestamp(time), TIMESTAMP_SIZE);
+    copyText(entry.message, MESSAGE_SIZE, message);
+    copyText(entry.imageUrl, IMAGE_URL_SIZE, imageUrl);
+    
+    entry.sequence = head.fetch_add(1, std::memory_order_acq_rel) + 1;
+    write(entry.sequence, entry);
+    return entry.sequence;
+}
+
+void AlertRing::write(uint64_t sequence, const Entry& entry) {
+    Slot& slot = slots[(sequence - 1) % slotCount];
+    
+    // Yuvanın önceki turu (sequence - kapasite) bitmeden yazılmaz
+    uint64_t expected = sequence > slotCount ? 2 * (sequence - slotCount) : 0;
+    while (slot.sequence.load(std::memory_order_acquire) != expected) {
+        std::this_thread::yield();
+    }
+    
+    uint64_t buffer[WORDS] = {};
+    std::memcpy(buffer, &entry, sizeof(Entry));
+    
+    slot.sequence.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) {
+        slot.words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * sequence, std::memory_order_release);
+}
+
+AlertRing::ReadResult AlertRing::read(uint64_t sequence, Entry& out) const {
+    const Slot& slot = slots[(sequence - 1) % slotCount];
+    
+    uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before < 2 * sequence) return ReadResult::PENDING;
+    if (before > 2 * sequence) return ReadResult::OVERWRITTEN;
+    
+    uint64_t buffer[WORDS];
+    for (size_t i = 0; i < WORDS; i++) {
+        buffer[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    
+    // Kopya sırasında yazar yuvaya girdiyse kayıt tutarsızdır
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        return ReadResult::OVERWRITTEN;
+    }
+    std::memcpy(&out, buffer, sizeof(Entry));
+    return ReadResult::OK;
+}
+
+uint64_t AlertRing::oldestVisible(uint64_t newest) const {
+    uint64_t evicted = newest > slotCount ? newest - slotCount : 0;
+    return std::max(evicted, clearedThrough.load(std::memory_order_acquire));
+}
+
+void AlertRing::clear() {
+    clearedThrough.store(head.load(std::memory_order_acquire), std::memory_order_release);
+}
\ No newline at end of file
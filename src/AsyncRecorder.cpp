@@ -0,0 +1,260 @@
+#include "AsyncRecorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+// Bu kadar süredir görülmeyen iz sahnede sayılmaz (kayıp iz tutma süresi)
+const MediaTime ACTIVE_TRACK_AGE(0.5);
+
+double unixSeconds() {
+    return std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+AsyncRecorder::AsyncRecorder(size_t queueCapacity, DropPolicy dropPolicy)
+    : capacity(std::max<size_t>(1, queueCapacity)), policy(dropPolicy),
+      recording(false), failed(false), hasActivity(false), hasKept(false), segment(0), segmentFrames(0), framesTotal(0),
+      stopRequested(false), drainOnStop(true) {
+}
+
+AsyncRecorder::~AsyncRecorder() {
+    stop(true);
+}
+
+std::string AsyncRecorder::segmentPath(uint32_t number) const {
+    if (config.segmentSeconds <= 0.0) {
+        return filename;
+    }
+    std::filesystem::path path(filename);
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "_%03u", number);
+    return (path.parent_path() /
+            (path.stem().string() + suffix + path.extension().string())).string();
+}
+
+bool AsyncRecorder::openSegment(uint32_t number, double wallTime) {
+    VideoUtils::RecordingConfig segmentConfig = config;
+    segmentConfig.filename = segmentPath(number);
+    writer = VideoUtils::createVideoWriter(segmentConfig);
+    segment = number;
+    segmentFrames = 0;
+    if (!writer.isOpened()) {
+        return false;
+    }
+    
+    // Yan dosya açılamazsa kayıt indekssiz sürer
+    RecordingIndex::Header header;
+    header.fourcc = VideoUtils::codecFourcc(config.codec);
+    header.fps = config.fps;
+    header.width = frameSize.width;
+    header.height = frameSize.height;
+    header.startTime = wallTime;
+    index.open(RecordingIndex::sidecarPath(segmentConfig.filename), header);
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stats.segments++;
+    return true;
+}
+
+void AsyncRecorder::closeSegment() {
+    writer.release();
+    index.close();
+}
+
+bool AsyncRecorder::start(const VideoUtils::RecordingConfig& recordingConfig) {
+    stop(true);
+    
+    config = recordingConfig;
+    filename = config.filename;
+    frameSize = VideoUtils::recordingSize(config);
+    framesTotal = 0;
+    failed = false;
+    hasActivity = false;
+    hasKept = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        frames.clear();
+        stats = Stats();
+        stopRequested = false;
+        drainOnStop = true;
+    }
+    
+    // İlk segment burada açılır: açılamazsa çağıran hemen öğrenir
+    if (!openSegment(0, unixSeconds())) {
+        closeSegment();
+        return false;
+    }
+    
+    encoder = std::thread(&AsyncRecorder::encoderLoop, this);
+    recording = true;
+    return true;
+}
+
+void AsyncRecorder::stop(bool drain) {
+    if (!encoder.joinable()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopRequested = true;
+        drainOnStop = drain;
+    }
+    queueCondition.notify_all();
+    encoder.join();
+    
+    closeSegment();
+    recording = false;
+}
+
+bool AsyncRecorder::submit(const cv::Mat& frame) {
+    return enqueue(Entry{frame, MediaTime(0.0), false, unixSeconds(), nullptr});
+}
+
+bool AsyncRecorder::submit(const cv::Mat& frame, MediaTime timestamp,
+                           TrackingSystem::TrackSnapshotPtr tracks) {
+    if (!isRecording() || frame.empty()) return false;
+    
+    if (shouldSkip(timestamp, tracks)) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stats.skipped++;
+        return false;
+    }
+    return enqueue(Entry{frame, timestamp, true, unixSeconds(), std::move(tracks)});
+}
+
+bool AsyncRecorder::enqueue(Entry entry) {
+    if (!isRecording() || entry.frame.empty()) return false;
+    
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stats.submitted++;
+        if (frames.size() >= capacity) {
+            stats.dropped++;
+            if (policy == DropPolicy::DROP_NEWEST) {
+                return false;
+            }
+            frames.pop_front();
+        }
+        frames.push_back(std::move(entry));
+        stats.peakQueued = std::max(stats.peakQueued, frames.size());
+    }
+    queueCondition.notify_one();
+    return true;
+}
+
+bool AsyncRecorder::hasMovingTracks(const TrackingSystem::TrackSnapshot& snapshot) {
+    for (const auto& track : snapshot.tracks) {
+        if (track.isMoving && snapshot.timestamp - track.lastSeen <= ACTIVE_TRACK_AGE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AsyncRecorder::shouldSkip(MediaTime timestamp,
+                               const TrackingSystem::TrackSnapshotPtr& tracks) {
+    if (config.idleFps <= 0.0) return false;
+    
+    // Medya zamanı geri gittiyse (FrameClock::reset: dedektör yeniden başlatıldı)
+    // durum sıfırlanır; video döngüsü zamanı geri götürmez
+    if ((hasKept && timestamp < lastKept) || (hasActivity && timestamp < lastActivity)) {
+        hasActivity = false;
+        hasKept = false;
+    }
+    
+    if (tracks && hasMovingTracks(*tracks)) {
+        lastActivity = timestamp;
+        hasActivity = true;
+    }
+    
+    bool active = hasActivity && timestamp - lastActivity <= MediaTime(config.activityHold);
+    bool due = !hasKept || timestamp - lastKept >= MediaTime(1.0 / config.idleFps);
+    if (!active && !due) {
+        return true;
+    }
+    lastKept = timestamp;
+    hasKept = true;
+    return false;
+}
+
+AsyncRecorder::Stats AsyncRecorder::getStats() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    Stats result = stats;
+    result.queued = frames.size();
+    return result;
+}
+
+void AsyncRecorder::encoderLoop() {
+    cv::Mat resized;
+    // MJPG'de her kare bağımsız; diğer kodeklerde anahtar kare konumu
+    // VideoWriter'dan öğrenilemez, yalnızca segment başı kesin bilinir
+    const bool intraOnly = VideoUtils::codecFourcc(config.codec) ==
+                           cv::VideoWriter::fourcc('M','J','P','G');
+    
+    while (true) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return stopRequested || !frames.empty(); });
+            if (frames.empty() || (stopRequested && !drainOnStop)) {
+                frames.clear();
+                return;
+            }
+            entry = std::move(frames.front());
+            frames.pop_front();
+        }
+        
+        MediaTime timestamp = entry.timed ? entry.timestamp :
+            MediaTime(config.fps > 0.0 ? framesTotal / config.fps : 0.0);
+        
+        // Segment sınırı. Medya zamanı geri gittiyse (FrameClock::reset: dedektör
+        // yeniden başlatıldı) de yeni segment açılır; .idx zamanları artan kalır
+        if (config.segmentSeconds > 0.0 && segmentFrames > 0 &&
+            (timestamp - segmentStart >= MediaTime(config.segmentSeconds) ||
+             timestamp < segmentStart)) {
+            closeSegment();
+            if (!openSegment(segment + 1, entry.wallTime)) {
+                // Kapalı yazıcıya sessizce yazmak yerine kayıt durur; bekleyenler düşer
+                closeSegment();
+                failed = true;
+                std::lock_guard<std::mutex> lock(queueMutex);
+                stats.segmentErrors++;
+                stats.dropped += frames.size() + 1;
+                frames.clear();
+                return;
+            }
+        }
+        if (segmentFrames == 0) {
+            segmentStart = timestamp;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        bool scaled = entry.frame.size() != frameSize;
+        if (scaled) {
+            // Yazıcı farklı boyutlu kareleri sessizce atar
+            cv::resize(entry.frame, resized, frameSize);
+        }
+        writer.write(scaled ? resized : entry.frame);
+        
+        index.appendFrame(segmentFrames, timestamp.count(), entry.wallTime,
+                          intraOnly || segmentFrames == 0);
+        if (entry.tracks && !entry.tracks->tracks.empty()) {
+            index.appendTracks(segmentFrames, *entry.tracks);
+        }
+        segmentFrames++;
+        framesTotal++;
+        double millis = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        
+        // Tamponu kuyruk kilidi dışında bırak
+        entry.frame.release();
+        entry.tracks.reset();
+        
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stats.written++;
+        if (scaled) stats.resized++;
+        stats.encodeMillis = stats.written == 1 ? millis : stats.encodeMillis * 0.95 + millis * 0.05;
+    }
+}
\ No newline at end of file
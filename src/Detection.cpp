@@ -21,6 +21,7 @@ Detection::Detection(const Detection& other) : bbox(other.bbox),
                                              direction(other.direction),
                                              trackId(other.trackId),
                                              faceImage(other.faceImage.clone()),
+                                             recognizedPerson(other.recognizedPerson),
                                              trajectory(other.trajectory) {
 }
 
@@ -38,6 +39,7 @@ Detection& Detection::operator=(const Detection& other) {
         direction = other.direction;
         trackId = other.trackId;
         faceImage = other.faceImage.clone();
+        recognizedPerson = other.recognizedPerson;
         trajectory = other.trajectory;
     }
     return *this;
@@ -0,0 +1,206 @@
+#include "EventBus.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+template <class... Ts> struct Overloaded : Ts... { using Ts::operator()...; };
+template <class... Ts> Overloaded(Ts...) -> Overloaded<Ts...>;
+
+std::string trackLabel(const EventBus::Event& event) {
+    return "Object ID " + std::to_string(event.trackId) + " (" + event.className + ")";
+}
+}
+
+EventBus::Subscription::Subscription(const std::string& name, size_t capacity)
+    : subscriberName(name), queue(capacity), delivered(0), dropped(0), waiting(false) {
+}
+
+size_t EventBus::Subscription::drain(const Handler& handler, size_t maxEvents) {
+    size_t count = 0;
+    EventPtr event;
+    while (count < maxEvents && queue.tryPop(event)) {
+        handler(*event);
+        event.reset();
+        count++;
+    }
+    return count;
+}
+
+EventBus::EventBus()
+    : subscribers(std::make_shared<const SubscriberList>()),
+      stopRequested(false), published(0) {
+}
+
+EventBus::~EventBus() {
+    shutdown();
+}
+
+void EventBus::addSubscriber(const SubscriptionPtr& subscription) {
+    // Kopyala-değiştir-yayımla: yayımcılar eski listeyi kilitsiz okumaya devam eder
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    auto updated = std::make_shared<SubscriberList>(*std::atomic_load(&subscribers));
+    updated->push_back(subscription);
+    std::atomic_store(&subscribers, std::shared_ptr<const SubscriberList>(std::move(updated)));
+}
+
+EventBus::SubscriptionPtr EventBus::subscribe(const std::string& name, size_t capacity) {
+    auto subscription = std::make_shared<Subscription>(name, capacity);
+    addSubscriber(subscription);
+    return subscription;
+}
+
+EventBus::SubscriptionPtr EventBus::subscribe(const std::string& name, Handler handler,
+                                              size_t capacity) {
+    auto subscription = std::make_shared<Subscription>(name, capacity);
+    
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    if (stopRequested) {
+        return subscription;  // Kapanmış veriyolu: abone hiçbir olay almaz
+    }
+    auto updated = std::make_shared<SubscriberList>(*std::atomic_load(&subscribers));
+    updated->push_back(subscription);
+    std::atomic_store(&subscribers, std::shared_ptr<const SubscriberList>(std::move(updated)));
+    workers.emplace_back(&EventBus::runSubscriber, this, subscription, std::move(handler));
+    return subscription;
+}
+
+void EventBus::unsubscribe(const SubscriptionPtr& subscription) {
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    auto updated = std::make_shared<SubscriberList>(*std::atomic_load(&subscribers));
+    updated->erase(std::remove(updated->begin(), updated->end(), subscription), updated->end());
+    std::atomic_store(&subscribers, std::shared_ptr<const SubscriberList>(std::move(updated)));
+}
+
+void EventBus::publish(Event event) {
+    if (event.wallTime == std::chrono::system_clock::time_point()) {
+        event.wallTime = std::chrono::system_clock::now();
+    }
+    
+    event.id = ++published;
+    
+    // Tek ayırma; her abone kuyruğuna yalnızca referans eklenir
+    EventPtr shared = std::make_shared<const Event>(std::move(event));
+    auto list = std::atomic_load(&subscribers);
+    
+    for (const auto& subscription : *list) {
+        if (!subscription->queue.tryPush(shared)) {
+            subscription->dropped++;
+            continue;
+        }
+        subscription->delivered++;
+        
+        // Uyuyan abone iş parçacığı varsa uyandır (yoğun akışta kilit alınmaz)
+        if (subscription->waiting.load()) {
+            std::lock_guard<std::mutex> lock(subscription->wakeMutex);
+            subscription->wakeCondition.notify_one();
+        }
+    }
+}
+
+void EventBus::runSubscriber(SubscriptionPtr subscription, Handler handler) {
+    while (true) {
+        if (subscription->drain(handler) > 0) {
+            continue;
+        }
+        if (stopRequested) {
+            return;
+        }
+        
+        // Uyumadan önce bayrak kaldırılır ve kuyruk yeniden denetlenir
+        std::unique_lock<std::mutex> lock(subscription->wakeMutex);
+        subscription->waiting = true;
+        if (subscription->queue.sizeApprox() == 0 && !stopRequested) {
+            subscription->wakeCondition.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS));
+        }
+        subscription->waiting = false;
+    }
+}
+
+void EventBus::shutdown() {
+    std::vector<std::thread> running;
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        stopRequested = true;
+        running.swap(workers);
+    }
+    
+    for (const auto& subscription : *std::atomic_load(&subscribers)) {
+        std::lock_guard<std::mutex> lock(subscription->wakeMutex);
+        subscription->wakeCondition.notify_all();
+    }
+    for (auto& worker : running) {
+        worker.join();
+    }
+}
+
+std::vector<EventBus::SubscriberStats> EventBus::getStats() const {
+    std::vector<SubscriberStats> stats;
+    for (const auto& subscription : *std::atomic_load(&subscribers)) {
+        stats.push_back({subscription->name(), subscription->deliveredCount(),
+                         subscription->droppedCount(), subscription->queuedCount()});
+    }
+    return stats;
+}
+
+std::string EventBus::describe(const Event& event) {
+    return std::visit(Overloaded{
+        [&](const TrackCreated&) {
+            return "New object detected: " + event.className;
+        },
+        [&](const TrackLost&) {
+            return trackLabel(event) + " lost";
+        },
+        [&](const FaceRecognized& e) {
+            return "Recognized person: " + e.person;
+        },
+        [&](const ZoneEntered& e) {
+            return trackLabel(event) + " entered restricted zone: " + e.zoneName;
+        },
+        [&](const ZoneExited& e) {
+            return trackLabel(event) + " left restricted zone: " + e.zoneName;
+        },
+        [&](const ZoneApproaching& e) {
+            std::stringstream ss;
+            ss << "Early warning: " << trackLabel(event)
+               << " expected to enter restricted zone: " << e.zoneName
+               << " in " << std::fixed << std::setprecision(1) << e.eta << " s";
+            return ss.str();
+        },
+        [&](const SpeedViolation& e) {
+            return "High speed movement detected: " +
+                   std::to_string(static_cast<int>(e.speed)) + " m/s";
+        },
+        [&](const NightActivity&) {
+            return "Night activity detected: " + event.className;
+        },
+        [&](const StationaryObject&) {
+            return "Suspicious stationary object: " + event.className;
+        },
+        [&](const WaterLevelThreshold& e) {
+            std::stringstream ss;
+            ss << "Water level " << std::fixed << std::setprecision(2) << e.level
+               << (e.rising ? " rose above " : " fell below ") << e.threshold;
+            return ss.str();
+        },
+        [&](const SystemStatus& e) {
+            return e.message;
+        }
+    }, event.payload);
+}
+
+std::string EventBus::coalesceKey(const Event& event) {
+    std::string id = std::to_string(event.trackId);
+    return std::visit(Overloaded{
+        [&](const ZoneEntered& e) { return "zone-enter:" + id + ":" + std::to_string(e.zone); },
+        [&](const ZoneExited& e) { return "zone-exit:" + id + ":" + std::to_string(e.zone); },
+        [&](const ZoneApproaching& e) { return "approach:" + id + ":" + std::to_string(e.zone); },
+        [&](const SpeedViolation&) { return "speed:" + id; },
+        // Eşik ve yön ayrı anahtar: uyarı geçişi kritik geçişi bastırmaz
+        [&](const WaterLevelThreshold& e) {
+            return std::string("water-level:") + (e.critical ? "critical" : "warning") +
+                   (e.rising ? ":up" : ":down");
+        },
+        [&](const auto&) { return std::string(); }  // Mesaj metni kullanılır
+    }, event.payload);
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "EventClipRecorder.hpp"
+#include "VideoUtils.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+EventClipRecorder::EventClipRecorder(const Config& config)
+    : config(config), stopRequested(false), ringBytes(0), pendingBytes(0) {
+    std::error_code error;
+    fs::create_directories(config.directory, error);
+    
+    encoder = std::thread(&EventClipRecorder::encoderLoop, this);
+    writer = std::thread(&EventClipRecorder::writerLoop, this);
+}
+
+EventClipRecorder::~EventClipRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    encodeCondition.notify_all();
+    encoder.join();
+    
+    // Kodlayıcı durduktan sonra açık klipler kapatılır; yazıcı kalanları bitirir
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& clip : clips) clip->closed = true;
+    }
+    clipCondition.notify_all();
+    writer.join();
+}
+
+void EventClipRecorder::setPublicBaseUrl(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex);
+    publicBaseUrl = url;
+    if (!publicBaseUrl.empty() && publicBaseUrl.back() != '/') {
+        publicBaseUrl += '/';
+    }
+}
+
+void EventClipRecorder::push(const cv::Mat& frame, MediaTime timestamp) {
+    if (frame.empty()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopRequested) return;
+        // Kodlayıcı geride kaldıysa kare atlanır; halka seyrekleşir ama tutarlı kalır
+        if (incoming.size() >= INCOMING_CAPACITY) {
+            stats.skipped++;
+            return;
+        }
+        incoming.emplace_back(frame, timestamp);
+    }
+    encodeCondition.notify_one();
+}
+
+std::string EventClipRecorder::trigger(const std::string& eventId, MediaTime eventTime) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopRequested) return "";
+    
+    MediaTime end = eventTime + MediaTime(config.postRollSeconds);
+    
+    // Süresi dolmamış klip varsa uzatılır
+    for (auto& clip : clips) {
+        if (!clip->closed && eventTime <= clip->end) {
+            clip->end = std::max(clip->end, end);
+            stats.clipsExtended++;
+            return publicBaseUrl.empty() ? clip->path
+                                         : publicBaseUrl + fs::path(clip->path).filename().string();
+        }
+    }
+    
+    std::string name = "event_" + VideoUtils::getTimeStamp() + "_" + eventId;
+    auto clip = std::make_shared<Clip>();
+    clip->path = (fs::path(config.directory) / (name + ".avi")).string();
+    clip->partPath = (fs::path(config.directory) / (name + ".part.avi")).string();
+    clip->end = end;
+    clip->lastTimestamp = MediaTime(-1.0);
+    
+    // Ön kayıt: halkadaki ilgili kareler (kopya yok, paylaşılan JPEG)
+    MediaTime start = eventTime - MediaTime(config.preRollSeconds);
+    for (const auto& frame : ring) {
+        if (frame->timestamp < start) continue;
+        clip->pending.push_back(frame);
+        clip->lastTimestamp = frame->timestamp;
+        pendingBytes += frame->jpeg.size();
+    }
+    
+    clips.push_back(clip);
+    stats.clipsStarted++;
+    clipCondition.notify_one();
+    return publicBaseUrl.empty() ? clip->path : publicBaseUrl + name + ".avi";
+}
+
+void EventClipRecorder::appendLocked(const FramePtr& frame) {
+    // Medya zamanı geri gittiyse (FrameClock::reset: dedektör yeniden başlatıldı)
+    // eski kareler atılır ve açık klipler kapanır. Video döngüsü zamanı geri
+    // götürmez (FrameClock döngü ofseti ekler).
+    if (!ring.empty() && frame->timestamp < ring.back()->timestamp) {
+        ring.clear();
+        ringBytes = 0;
+        for (auto& clip : clips) clip->closed = true;
+        clipCondition.notify_one();
+    }
+    
+    // Halka: hem süre hem bayt sınırı
+    ring.push_back(frame);
+    ringBytes += frame->jpeg.size();
+    MediaTime oldest = frame->timestamp - MediaTime(config.preRollSeconds);
+    while (!ring.empty() && (ringBytes > config.memoryBudget || ring.front()->timestamp < oldest)) {
+        ringBytes -= ring.front()->jpeg.size();
+        ring.pop_front();
+    }
+    
+    // Açık klipler: son kayıt bitene kadar kareyi alır
+    bool notify = false;
+    for (auto& clip : clips) {
+        if (clip->closed || frame->timestamp <= clip->lastTimestamp) continue;
+        if (frame->timestamp > clip->end) {
+            clip->closed = true;
+            notify = true;
+            continue;
+        }
+        if (pendingBytes + frame->jpeg.size() > config.memoryBudget) {
+            stats.clipFramesDropped++;
+            continue;
+        }
+        clip->pending.push_back(frame);
+        clip->lastTimestamp = frame->timestamp;
+        pendingBytes += frame->jpeg.size();
+        notify = true;
+    }
+    if (notify) clipCondition.notify_one();
+}
+
+void EventClipRecorder::encoderLoop() {
+    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, config.jpegQuality};
+    
+    while (true) {
+        std::pair<cv::Mat, MediaTime> item;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            encodeCondition.wait(lock, [this]() { return stopRequested || !incoming.empty(); });
+            if (stopRequested) {
+                incoming.clear();
+                return;
+            }
+            item = std::move(incoming.front());
+            incoming.pop_front();
+        }
+        
+        auto encoded = std::make_shared<EncodedFrame>();
+        encoded->timestamp = item.second;
+        bool ok = cv::imencode(".jpg", item.first, encoded->jpeg, params);
+        item.first.release();  // Kaynak tampon kilit dışında bırakılır
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ok) {
+            stats.failed++;
+            continue;
+        }
+        stats.encoded++;
+        appendLocked(encoded);
+    }
+}
+
+double EventClipRecorder::estimateFps(const std::deque<FramePtr>& frames) const {
+    if (config.fps > 0) return config.fps;
+    if (frames.size() >= 2) {
+        double span = (frames.back()->timestamp - frames.front()->timestamp).count();
+        if (span > 0) return (frames.size() - 1) / span;
+    }
+    return 15.0;
+}
+
+bool EventClipRecorder::writeFrames(Clip& clip, const std::deque<FramePtr>& frames, cv::Mat& decoded) {
+    for (const auto& frame : frames) {
+        decoded = cv::imdecode(frame->jpeg, cv::IMREAD_COLOR);
+        if (decoded.empty()) continue;
+        
+        if (!clip.writer.isOpened()) {
+            // Kare hızı ilk parti kare zamanlarından; çözünürlük ilk kareden
+            clip.writer.open(clip.partPath, VideoUtils::codecFourcc(VideoUtils::Codec::MJPG),
+                             estimateFps(frames), decoded.size(), true);
+            if (!clip.writer.isOpened()) return false;
+        }
+        clip.writer.write(decoded);
+    }
+    return true;
+}
+
+void EventClipRecorder::writerLoop() {
+    cv::Mat decoded;
+    
+    while (true) {
+        ClipPtr clip;
+        std::deque<FramePtr> frames;
+        bool finished = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto ready = [this]() {
+                return std::find_if(clips.begin(), clips.end(), [](const ClipPtr& c) {
+                    return !c->pending.empty() || c->closed;
+                }) != clips.end();
+            };
+            clipCondition.wait(lock, [&]() { return ready() || (stopRequested && clips.empty()); });
+            if (!ready()) return;  // Durduruldu ve yazılacak klip kalmadı
+            
+            auto it = std::find_if(clips.begin(), clips.end(), [](const ClipPtr& c) {
+                return !c->pending.empty() || c->closed;
+            });
+            clip = *it;
+            frames.swap(clip->pending);
+            for (const auto& frame : frames) pendingBytes -= frame->jpeg.size();
+            finished = clip->closed;
+            if (finished) clips.erase(it);
+        }
+        
+        if (!clip->failed && !writeFrames(*clip, frames, decoded)) {
+            clip->failed = true;
+        }
+        frames.clear();
+        if (!finished) continue;
+        
+        // Kapanış: tam dosya yeni adıyla görünür
+        bool ok = !clip->failed && clip->writer.isOpened();
+        clip->writer.release();
+        if (ok) ok = std::rename(clip->partPath.c_str(), clip->path.c_str()) == 0;
+        if (!ok) {
+            std::error_code error;
+            fs::remove(clip->partPath, error);
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ok) stats.clipsWritten++;
+        else stats.failed++;
+    }
+}
+
+EventClipRecorder::Stats EventClipRecorder::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = stats;
+    result.ringFrames = ring.size();
+    result.ringBytes = ringBytes;
+    result.ringSeconds = ring.size() >= 2
+        ? (ring.back()->timestamp - ring.front()->timestamp).count() : 0.0;
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,377 @@
+#include "FaceGallery.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char GALLERY_MAGIC[8] = {'F', 'A', 'S', 'T', 'Y', 'F', 'G', '1'};
+const uint32_t GALLERY_VERSION = 1;
+const uint64_t INITIAL_CAPACITY = 256;
+}
+
+FaceGallery::FaceGallery() {
+}
+
+FaceGallery::~FaceGallery() {
+    close();
+}
+
+size_t FaceGallery::labelOffset(uint64_t capacity) {
+    return sizeof(Header) + capacity * DESCRIPTOR_SIZE * sizeof(float);
+}
+
+size_t FaceGallery::regionSize(uint64_t capacity) {
+    return labelOffset(capacity) + capacity * LABEL_SIZE;
+}
+
+float* FaceGallery::descriptorRow(size_t row) const {
+    return reinterpret_cast<float*>(mapping + sizeof(Header)) + row * DESCRIPTOR_SIZE;
+}
+
+char* FaceGallery::labelSlot(size_t row) const {
+    return reinterpret_cast<char*>(mapping + labelOffset(header()->capacity)) + row * LABEL_SIZE;
+}
+
+bool FaceGallery::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    failed = false;
+    unmapRegion();
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    // Yeni galeri dosyası
+    if (st.st_size == 0) {
+        if (!mapRegion(INITIAL_CAPACITY)) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        Header* h = header();
+        std::memset(h, 0, sizeof(Header));
+        std::memcpy(h->magic, GALLERY_MAGIC, sizeof(h->magic));
+        h->version = GALLERY_VERSION;
+        h->dimension = DESCRIPTOR_SIZE;
+        h->capacity = INITIAL_CAPACITY;
+        return true;
+    }
+
+    // Mevcut galeriyi doğrula ve eşle
+    Header existing;
+    bool valid = static_cast<size_t>(st.st_size) >= sizeof(Header) &&
+                 pread(fd, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+                 std::memcmp(existing.magic, GALLERY_MAGIC, sizeof(existing.magic)) == 0 &&
+                 existing.version == GALLERY_VERSION &&
+                 existing.dimension == DESCRIPTOR_SIZE &&
+                 existing.count <= existing.capacity &&
+                 regionSize(existing.capacity) <= static_cast<size_t>(st.st_size);
+
+    if (!valid || !mapRegion(existing.capacity)) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void FaceGallery::close() {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    unmapRegion();
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+void FaceGallery::flush() {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    if (mapping && fd >= 0) {
+        msync(mapping, mappingSize, MS_ASYNC);
+    }
+}
+
+bool FaceGallery::isPersistent() const {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    return fd >= 0;
+}
+
+bool FaceGallery::isFailed() const {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    return failed;
+}
+
+void FaceGallery::setMatchThreshold(DescriptorType type, float threshold) {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    (type == DescriptorType::EMBEDDING ? embeddingThreshold : gradientThreshold) = threshold;
+}
+
+float FaceGallery::getMatchThreshold(DescriptorType type) const {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    return type == DescriptorType::EMBEDDING ? embeddingThreshold : gradientThreshold;
+}
+
+size_t FaceGallery::size() const {
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    return mapping ? static_cast<size_t>(header()->count) : 0;
+}
+
+bool FaceGallery::mapRegion(uint64_t capacity) {
+    size_t size = regionSize(capacity);
+    void* region;
+
+    if (fd >= 0) {
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return false;
+        }
+        region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    } else {
+        region = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (region == MAP_FAILED) {
+        return false;
+    }
+
+    mapping = static_cast<uint8_t*>(region);
+    mappingSize = size;
+    return true;
+}
+
+void FaceGallery::unmapRegion() {
+    if (mapping) {
+        if (fd >= 0) {
+            msync(mapping, mappingSize, MS_SYNC);
+        }
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+}
+
+bool FaceGallery::reserve(uint64_t capacity) {
+    if (failed) {
+        return false;
+    }
+    if (mapping && header()->capacity >= capacity) {
+        return true;
+    }
+
+    uint64_t newCapacity = std::max(capacity, INITIAL_CAPACITY);
+
+    // İlk kullanım (dosya açılmadan): bellek içi galeri
+    if (!mapping) {
+        if (!mapRegion(newCapacity)) return false;
+        Header* h = header();
+        std::memset(h, 0, sizeof(Header));
+        std::memcpy(h->magic, GALLERY_MAGIC, sizeof(h->magic));
+        h->version = GALLERY_VERSION;
+        h->dimension = DESCRIPTOR_SIZE;
+        h->capacity = newCapacity;
+        return true;
+    }
+
+    Header saved = *header();
+    newCapacity = std::max(newCapacity, saved.capacity * 2);
+
+    // İsim bölgesi kapasiteye bağlı konumda; büyütmeden önce sakla
+    std::vector<char> labels(labelSlot(0), labelSlot(0) + saved.count * LABEL_SIZE);
+
+    uint8_t* oldMapping = mapping;
+    size_t oldSize = mappingSize;
+
+    if (fd >= 0) {
+        // Dosya büyütülür; tanımlayıcılar yerinde kalır
+        msync(oldMapping, oldSize, MS_SYNC);
+        munmap(oldMapping, oldSize);
+        mapping = nullptr;
+        if (!mapRegion(newCapacity)) {
+            // Eski boyutla geri eşlenemezse galeri kapatılır (mapping boş kalır)
+            if (!mapRegion(saved.capacity)) {
+                ::close(fd);
+                fd = -1;
+                failed = true;
+            }
+            return false;
+        }
+    } else {
+        mapping = nullptr;
+        if (!mapRegion(newCapacity)) {
+            mapping = oldMapping;
+            mappingSize = oldSize;
+            return false;
+        }
+        std::memcpy(mapping, oldMapping, labelOffset(saved.capacity));
+        munmap(oldMapping, oldSize);
+    }
+
+    // Başlık en son güncellenir: yarıda kalan büyütmede eski düzen geçerli kalır
+    std::memcpy(mapping + labelOffset(newCapacity), labels.data(), labels.size());
+    header()->capacity = newCapacity;
+    return true;
+}
+
+bool FaceGallery::setEmbeddingModel(const std::string& modelPath) {
+    try {
+        cv::dnn::Net net = cv::dnn::readNet(modelPath);
+        if (net.empty()) return false;
+
+        std::lock_guard<std::mutex> lock(embeddingMutex);
+        embeddingNet = net;
+        hasEmbeddingNet = true;
+        return true;
+    } catch (const cv::Exception&) {
+        return false;
+    }
+}
+
+cv::Mat FaceGallery::computeDescriptor(const cv::Mat& face, DescriptorType* type) {
+    if (face.empty()) return cv::Mat();
+
+    {
+        std::lock_guard<std::mutex> lock(embeddingMutex);
+        if (hasEmbeddingNet) {
+            cv::Mat blob = cv::dnn::blobFromImage(face, 1.0 / 255.0, cv::Size(96, 96),
+                                                  cv::Scalar(), true, false);
+            embeddingNet.setInput(blob);
+            cv::Mat embedding = embeddingNet.forward().reshape(1, 1);
+            if (embedding.total() == DESCRIPTOR_SIZE) {
+                cv::Mat descriptor;
+                embedding.convertTo(descriptor, CV_32F);
+                cv::normalize(descriptor, descriptor);
+                if (type) *type = DescriptorType::EMBEDDING;
+                return descriptor;
+            }
+        }
+    }
+
+    // Model yoksa: 4x4 hücre x 8 yön gradyan histogramı (HOG benzeri, 128 boyut)
+    cv::Mat gray;
+    if (face.channels() == 3) {
+        cv::cvtColor(face, gray, cv::COLOR_BGR2GRAY);
+    } else {
+        gray = face;
+    }
+    cv::resize(gray, gray, cv::Size(64, 64), 0, 0, cv::INTER_AREA);
+    cv::equalizeHist(gray, gray);
+
+    cv::Mat gx, gy, magnitude, angle;
+    cv::Sobel(gray, gx, CV_32F, 1, 0);
+    cv::Sobel(gray, gy, CV_32F, 0, 1);
+    cv::cartToPolar(gx, gy, magnitude, angle);
+
+    const int CELL_SIZE = 16;
+    const int BINS = 8;
+    cv::Mat descriptor = cv::Mat::zeros(1, DESCRIPTOR_SIZE, CV_32F);
+    float* hist = descriptor.ptr<float>();
+
+    for (int y = 0; y < magnitude.rows; y++) {
+        const float* mag = magnitude.ptr<float>(y);
+        const float* ang = angle.ptr<float>(y);
+        float* cellRow = hist + (y / CELL_SIZE) * 4 * BINS;
+        for (int x = 0; x < magnitude.cols; x++) {
+            // İşaretsiz yön (0-π)
+            float a = ang[x] >= CV_PI ? ang[x] - static_cast<float>(CV_PI) : ang[x];
+            int bin = std::min(BINS - 1, static_cast<int>(a * BINS / CV_PI));
+            cellRow[(x / CELL_SIZE) * BINS + bin] += mag[x];
+        }
+    }
+
+    cv::sqrt(descriptor, descriptor);  // Hellinger çekirdeği
+    cv::normalize(descriptor, descriptor);
+    if (type) *type = DescriptorType::GRADIENT;
+    return descriptor;
+}
+
+int FaceGallery::enroll(const cv::Mat& face, const std::string& name) {
+    DescriptorType type = DescriptorType::GRADIENT;
+    cv::Mat descriptor = computeDescriptor(face, &type);
+    return enrollDescriptor(descriptor, name, type);
+}
+
+int FaceGallery::enrollDescriptor(const cv::Mat& descriptor, const std::string& name,
+                                  DescriptorType type) {
+    if (descriptor.total() != DESCRIPTOR_SIZE || name.empty()) return -1;
+
+    cv::Mat row;
+    descriptor.reshape(1, 1).convertTo(row, CV_32F);
+    cv::normalize(row, row);
+
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    uint64_t count = mapping ? header()->count : 0;
+    if (!reserve(count + 1)) return -1;
+
+    std::memcpy(descriptorRow(count), row.ptr<float>(), DESCRIPTOR_SIZE * sizeof(float));
+
+    char* label = labelSlot(count);
+    std::memset(label, 0, LABEL_SIZE);
+    std::memcpy(label, name.data(), std::min(name.size(), static_cast<size_t>(LABEL_TYPE_OFFSET - 1)));
+    label[LABEL_TYPE_OFFSET] = static_cast<char>(type);
+
+    // Sayaç en son artar: satır tamamen yazılmadan görünmez
+    header()->count = count + 1;
+    return static_cast<int>(count);
+}
+
+FaceGallery::Match FaceGallery::search(const cv::Mat& descriptor, DescriptorType type) const {
+    Match match;
+    if (descriptor.total() != DESCRIPTOR_SIZE) return match;
+
+    cv::Mat query;
+    descriptor.reshape(1, 1).convertTo(query, CV_32F);
+    cv::normalize(query, query);
+
+    std::lock_guard<std::mutex> lock(galleryMutex);
+    if (!mapping || header()->count == 0) return match;
+
+    // Tüm galeriye karşı tek GEMM: N x 128 * 128 x 1
+    cv::Mat gallery(static_cast<int>(header()->count), DESCRIPTOR_SIZE, CV_32F,
+                    descriptorRow(0));
+    cv::Mat scores;
+    cv::gemm(gallery, query, 1.0, cv::noArray(), 0.0, scores, cv::GEMM_2_T);
+
+    // En iyi skor yalnızca sorguyla aynı türdeki satırlar arasından
+    const char wanted = static_cast<char>(type);
+    const float* score = scores.ptr<float>();
+    int bestRow = -1;
+    float best = -1.0f;
+    for (int row = 0; row < scores.rows; row++) {
+        if (labelSlot(row)[LABEL_TYPE_OFFSET] != wanted) continue;
+        if (score[row] > best) {
+            best = score[row];
+            bestRow = row;
+        }
+    }
+
+    float threshold = type == DescriptorType::EMBEDDING ? embeddingThreshold : gradientThreshold;
+    if (bestRow >= 0 && best >= threshold) {
+        const char* label = labelSlot(bestRow);
+        match.index = bestRow;
+        match.name.assign(label, strnlen(label, LABEL_TYPE_OFFSET));
+        match.similarity = best;
+    }
+    return match;
+}
+
+FaceGallery::Match FaceGallery::identify(const cv::Mat& face) {
+    DescriptorType type = DescriptorType::GRADIENT;
+    cv::Mat descriptor = computeDescriptor(face, &type);
+    return search(descriptor, type);
+}
\ No newline at end of file
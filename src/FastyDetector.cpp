@@ -1,19 +1,39 @@
 #include "FastyDetector.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include "VideoUtils.hpp"
 
 FastyDetector::FastyDetector() {
+    alerts = std::make_shared<AlertRing>(settings.maxAlerts);
     generateColors();
     settings.detectionArea = cv::Rect(0, 0, 0, 0); // Full frame
     trackingSystem = std::make_unique<TrackingSystem>();
     notificationSystem = std::make_unique<NotificationSystem>();
+    faceGallery = std::make_shared<FaceGallery>();
+    trackingSystem->setFaceGallery(faceGallery);
+    snapshotEncoder = std::make_shared<SnapshotEncoder>(SNAPSHOT_DIR);
+    EventClipRecorder::Config clipConfig;
+    clipConfig.directory = CLIP_DIR;
+    clipRecorder = std::make_shared<EventClipRecorder>(clipConfig);
+    
+    // İzleyici olayları veriyoluna yayımlar; bildirim ve arayüz ayrı abonelerdir
+    eventBus = std::make_shared<EventBus>();
+    trackingSystem->setEventBus(eventBus);
+    eventBus->subscribe("notifier", [this](const EventBus::Event& event) {
+        notifyEvent(event);
+    });
+    alertEvents = eventBus->subscribe("alerts", 256);
 }
 
 FastyDetector::~FastyDetector() {
     stop();
+    // Abone iş parçacıkları bildirim sistemi yok edilmeden durmalı
+    eventBus->shutdown();
 }
 
 void FastyDetector::generateColors() {
@@ -42,6 +62,17 @@ bool FastyDetector::configure(const InputSettings& settings) {
         return false;
     }
     
+    // Yüz galerisi (bellek eşlemeli, açılış anlık)
+    if (!faceGallery->open(FACE_GALLERY_PATH)) {
+        addAlert("Yüz galerisi açılamadı, bellek içi galeri kullanılıyor", 3);
+    }
+    faceGallery->setEmbeddingModel(FACE_EMBEDDING_MODEL);
+    
+    // Bildirim spool'u: kesinti/yeniden başlatmada gönderilmemişler kaybolmaz
+    if (!notificationSystem->enableSpool(NOTIFICATION_SPOOL_DIR)) {
+        addAlert("Bildirim spool'u açılamadı, bildirimler yalnızca bellekte", 3);
+    }
+    
     // Enhanced mode ayarları
     if (settings.enhancedMode) {
         this->settings.confidenceThreshold = 0.4f;
@@ -83,6 +114,8 @@ bool FastyDetector::start() {
             addAlert(ss.str(), 2);
         }
         
+        frameClock.reset();
+        lastFrameWallTime = std::chrono::steady_clock::now();
         isInitialized = true;
         return true;
     }
@@ -136,20 +169,33 @@ bool FastyDetector::getNextFrame(cv::Mat& frame) {
         return false;
     }
     
-    static auto lastTime = std::chrono::steady_clock::now();
-    auto currentTime = std::chrono::steady_clock::now();
-    deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
-    currentFPS = 1.0f / deltaTime;
-    lastTime = currentTime;
+    // İşleme hızı duvar saatiyle ölçülür (yalnızca gösterim için)
+    auto wallTime = std::chrono::steady_clock::now();
+    float wallDelta = std::chrono::duration<float>(wallTime - lastFrameWallTime).count();
+    if (wallDelta > 0) {
+        currentFPS = 1.0f / wallDelta;
+    }
+    lastFrameWallTime = wallTime;
 
+    // Önceki kare uyarı görüntüsü olarak kuyruktaysa üzerine yazılmaz
+    VideoUtils::detachIfShared(frame);
     if (!capture.read(frame)) {
         return false;
     }
     
+    // Analiz zamanı medya zaman damgasından gelir
+    bool isCamera = inputSettings.sourceType == InputSettings::SourceType::CAMERA;
+    frameClock.stamp(capture, isCamera);
+    
     if (frame.size() != cv::Size(inputSettings.width, inputSettings.height)) {
         cv::resize(frame, frame, cv::Size(inputSettings.width, inputSettings.height));
     }
     
+    // Ön kayıt halkası (kodlama arka planda; kare kopyalanmaz)
+    if (clipRecorder) {
+        clipRecorder->push(frame, frameClock.now());
+    }
+    
     return true;
 }
 
@@ -201,22 +247,13 @@ bool FastyDetector::detectFace(const cv::Mat& frame, cv::Rect& faceRect) {
 void FastyDetector::processFaceRecognition(Detection& detection) {
     if (!detection.hasFace() || !settings.enableFaceRecognition) return;
     
+    if (!faceGallery || faceGallery->size() == 0) return;
+    
     try {
-        cv::Mat face;
-        cv::resize(detection.faceImage, face, cv::Size(128, 128));
-        cv::cvtColor(face, face, cv::COLOR_BGR2GRAY);
-        
-        if (!faceRecognizer) {
-            faceRecognizer = cv::face::LBPHFaceRecognizer::create();
-            // Burada önceden eğitilmiş model yüklenebilir
-            // faceRecognizer->read("models/face_model.yml");
+        FaceGallery::Match match = faceGallery->identify(detection.faceImage);
+        if (match.index >= 0) {
+            detection.recognizedPerson = match.name;
         }
-        
-        // Yüz tanıma işlemi burada yapılabilir
-        // int label;
-        // double confidence;
-        // faceRecognizer->predict(face, label, confidence);
-        
     } catch (const cv::Exception& e) {
         addAlert("Yüz tanıma hatası: " + std::string(e.what()), 3);
     }
@@ -317,10 +354,12 @@ std::vector<Detection> FastyDetector::detect(const cv::Mat& frame) {
             finalDetections.push_back(detections[idx]);
         }
 
-        updateMotionTracking(finalDetections);
+        // Tek eşleştirme geçişi: iz ID, hız ve yön izleyiciden gelir
+        trackingSystem->updateTracks(finalDetections, frame, frameClock.now());
+        collectEventAlerts();
 
         for (const auto& det : finalDetections) {
-            checkDangerousConditions(det);
+            checkDangerousConditions(det, frame);
         }
 
         return finalDetections;
@@ -380,41 +419,7 @@ float FastyDetector::calculateDistance(const cv::Rect& bbox) {
     return distance;
 }
 
-void FastyDetector::updateMotionTracking(std::vector<Detection>& detections) {
-    for (auto& det : detections) {
-        auto prevIt = previousDetections.find(det.classId);
-        if (prevIt != previousDetections.end()) {
-            const auto& prev = prevIt->second;
-            det.velocity = calculateVelocity(det.center, prev.center);
-            det.direction = calculateDirection(det.center, prev.center);
-            det.isMoving = det.velocity > 0.5f;
-        }
-    }
-    
-    previousDetections.clear();
-    for (const auto& det : detections) {
-        previousDetections[det.classId] = det;
-    }
-}
-
-float FastyDetector::calculateVelocity(const cv::Point& current, 
-                                     const cv::Point& previous) {
-    float pixelDistance = cv::norm(current - previous);
-    float realDistance = pixelDistance * (PERSON_HEIGHT / current.y);
-    return realDistance / deltaTime;
-}
-
-cv::Point2f FastyDetector::calculateDirection(const cv::Point& current,
-                                            const cv::Point& previous) {
-    cv::Point2f diff = current - previous;
-    float norm = cv::norm(diff);
-    if (norm > 0) {
-        return diff / norm;
-    }
-    return cv::Point2f(0, 0);
-}
-
-void FastyDetector::checkDangerousConditions(const Detection& det) {
+void FastyDetector::checkDangerousConditions(const Detection& det, const cv::Mat& frame) {
     if (!det.isPerson) return;
     
     if (det.velocity > DANGER_SPEED) {
@@ -422,11 +427,14 @@ void FastyDetector::checkDangerousConditions(const Detection& det) {
         ss << "Tehlikeli hız tespit edildi: " 
            << std::fixed << std::setprecision(1) 
            << det.velocity << " m/s";
-        addAlert(ss.str(), 4);
+        addAlert(ss.str(), 4, "danger-speed:" + std::to_string(det.trackId),
+                 SnapshotEncoder::contextCrop(frame, det.bbox));
     }
     
     if (det.distance < 2.0f) {
-        addAlert("Çok yakın mesafe tespit edildi!", 5);
+        addAlert("Çok yakın mesafe tespit edildi!", 5,
+                 "danger-near:" + std::to_string(det.trackId),
+                 SnapshotEncoder::contextCrop(frame, det.bbox));
     }
 }
 
@@ -442,42 +450,32 @@ void FastyDetector::drawDetections(cv::Mat& frame,
         // Tespit kutusu
         cv::rectangle(frame, det.bbox, color, 2);
         
-        // Nesne bilgisi ve mesafe
-        std::stringstream ss;
-        ss << det.className << " (" 
-           << std::fixed << std::setprecision(1) 
-           << det.confidence * 100 << "%)";
-        
-        // Mesafe bilgisi
-        ss << "\nMesafe: " 
-           << std::fixed << std::setprecision(1) 
-           << det.distance << "m";
-        
-        // Hız bilgisi
+        // Nesne bilgisi, mesafe ve hız; değerler ekran hassasiyetinde
+        // nicemlendiğinden aynı metinler kareler arasında tekrarlanır
+        char text[3][64];
+        int lineCount = 0;
+        std::snprintf(text[lineCount++], sizeof(text[0]), "%s (%.0f%%)",
+                      det.className.c_str(), det.confidence * 100);
+        std::snprintf(text[lineCount++], sizeof(text[0]), "Mesafe: %.1fm", det.distance);
         if (det.isMoving) {
-            ss << "\nHiz: " 
-               << std::fixed << std::setprecision(1) 
-               << det.velocity << " m/s";
-        }
-        
-        // Bilgi kutusu
-        std::vector<std::string> lines;
-        std::string line;
-        std::istringstream text(ss.str());
-        while (std::getline(text, line)) {
-            lines.push_back(line);
+            std::snprintf(text[lineCount++], sizeof(text[0]), "Hiz: %.1f m/s", det.velocity);
         }
         
-        int baseLine;
+        // Etiket sprite'ları (önbellekte yoksa bir kez rasterleştirilir)
+        LabelCache::Style style;
+        style.background = color;
+        LabelCache::Label lines[3];
+        int baseLine = 0;
         int maxWidth = 0;
-        for (const auto& line : lines) {
-            cv::Size textSize = cv::getTextSize(
-                line, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseLine);
-            maxWidth = std::max(maxWidth, textSize.width);
+        for (int i = 0; i < lineCount; i++) {
+            labelText.assign(text[i]);
+            lines[i] = labelCache.get(labelText, style);
+            baseLine = lines[i].baseline;
+            maxWidth = std::max(maxWidth, lines[i].textSize.width);
         }
         
         // Arka plan kutusu
-        int totalHeight = (lines.size() * (baseLine + 25));
+        int totalHeight = (lineCount * (baseLine + 25));
         cv::rectangle(frame, 
                      cv::Point(det.bbox.x, det.bbox.y - totalHeight - 10),
                      cv::Point(det.bbox.x + maxWidth + 10, det.bbox.y),
@@ -485,11 +483,8 @@ void FastyDetector::drawDetections(cv::Mat& frame,
         
         // Metin
         int y = det.bbox.y - totalHeight + 20;
-        for (const auto& line : lines) {
-            cv::putText(frame, line, 
-                       cv::Point(det.bbox.x + 5, y),
-                       cv::FONT_HERSHEY_SIMPLEX, 0.5, 
-                       cv::Scalar(255,255,255), 1);
+        for (int i = 0; i < lineCount; i++) {
+            LabelCache::blit(frame, lines[i], cv::Point(det.bbox.x + 5, y));
             y += 25;
         }
         
@@ -510,34 +505,134 @@ void FastyDetector::drawDetections(cv::Mat& frame,
     }
 }
 
+void FastyDetector::drawTrajectories(cv::Mat& frame) {
+    trackingSystem->drawTrajectories(frame);
+}
+
+TrackingSystem::TrackSnapshotPtr FastyDetector::getTrackedObjects() const {
+    return trackingSystem->getTracks();
+}
+
 void FastyDetector::drawInfo(cv::Mat& frame, const std::string& info) {
     cv::putText(frame, info, cv::Point(10, frame.rows - 20),
                 cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(0, 255, 0), 2);
 }
 
-void FastyDetector::addAlert(const std::string& message, int priority) {
+void FastyDetector::addAlert(const std::string& message, int priority,
+                             const std::string& coalesceKey,
+                             const cv::Mat& snapshot) {
     auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    
-    Alert alert;
-    alert.message = message;
-    alert.priority = priority;
-    alert.timestamp = std::ctime(&time);
-    
-    alerts.push_front(alert);
-    if (alerts.size() > MAX_ALERTS) {
-        alerts.pop_back();
-    }
+    std::string imageUrl;
     
     if (notificationSystem) {
+        // Görüntü, bildirim kabul edilirse kuyruğa girer (referans, kopya yok)
+        std::function<std::string()> imageProvider;
+        if (!snapshot.empty() && snapshotEncoder) {
+            imageProvider = [this, &snapshot, &imageUrl]() {
+                imageUrl = snapshotEncoder->submit(snapshot, "alert");
+                return imageUrl;
+            };
+        }
+        // Sahneye bağlı tehlike uyarıları (görüntülü) veriyolu olayları gibi klip alır;
+        // sistem hataları almaz
+        std::function<std::string()> clipProvider;
+        if (!snapshot.empty() && priority >= CLIP_MIN_PRIORITY && clipRecorder) {
+            std::string eventId = coalesceKey.empty() ? "alert" : coalesceKey;
+            std::replace(eventId.begin(), eventId.end(), ':', '-');
+            clipProvider = [this, eventId]() {
+                return clipRecorder->trigger(eventId, getFrameTimestamp());
+            };
+        }
+        
         notificationSystem->sendNotification({
             NotificationSystem::NotificationType::SECURITY_ALERT,
             message,
-            alert.timestamp,
+            AlertRing::formatTimestamp(now),
             priority,
-            ""  // imageUrl
+            "",  // imageUrl
+            coalesceKey,
+            imageProvider,
+            "",  // clipUrl
+            clipProvider
         });
     }
+    
+    std::atomic_load(&alerts)->push(message, priority, cv::Point(), imageUrl, now);
+}
+
+void FastyDetector::collectEventAlerts() {
+    // Arayüz listesi yalnızca önemli olayları gösterir (öncelik 2+)
+    auto ring = std::atomic_load(&alerts);
+    alertEvents->drain([&ring](const EventBus::Event& event) {
+        if (event.priority < 2) return;
+        ring->push(EventBus::describe(event), event.priority, cv::Point(), "", event.wallTime);
+    });
+}
+
+void FastyDetector::resizeAlerts(size_t capacity) {
+    auto current = std::atomic_load(&alerts);
+    if (current->capacity() == capacity) return;
+    
+    // Yeni halka eskisinin son kayıtlarını alır; eski halkaya yazan iş
+    // parçacıkları işini bitirene kadar o halkayı tutar
+    std::atomic_store(&alerts, std::make_shared<AlertRing>(capacity, *current));
+}
+
+void FastyDetector::notifyEvent(const EventBus::Event& event) {
+    using Type = NotificationSystem::NotificationType;
+    
+    // İz kaybı ve sistem durumu yalnızca kayıt/metrik aboneleri içindir; bilgi
+    // düzeyindeki olaylar (yeni iz, bölgeden çıkış, gece görüşü, bölge
+    // değişikliği) webhook/Pushover/email'e gitmez
+    if (std::holds_alternative<EventBus::TrackLost>(event.payload) ||
+        std::holds_alternative<EventBus::SystemStatus>(event.payload) ||
+        event.priority < NOTIFY_MIN_PRIORITY) {
+        return;
+    }
+    
+    Type type = Type::SECURITY_ALERT;
+    if (std::holds_alternative<EventBus::TrackCreated>(event.payload)) {
+        type = Type::MOTION_DETECTED;
+    } else if (std::holds_alternative<EventBus::FaceRecognized>(event.payload)) {
+        type = Type::FACE_RECOGNIZED;
+    } else if (std::holds_alternative<EventBus::ZoneEntered>(event.payload) ||
+               std::holds_alternative<EventBus::ZoneExited>(event.payload) ||
+               std::holds_alternative<EventBus::ZoneApproaching>(event.payload)) {
+        type = Type::ZONE_VIOLATION;
+    } else if (std::holds_alternative<EventBus::NightActivity>(event.payload)) {
+        type = Type::NIGHT_ACTIVITY;
+    }
+    
+    // Görüntü yalnızca bildirim kabul edilirse kodlanır
+    std::function<std::string()> imageProvider;
+    if (!event.snapshot.empty() && snapshotEncoder) {
+        imageProvider = [this, &event]() {
+            return snapshotEncoder->submit(event.snapshot, "event");
+        };
+    }
+    // Önemli olaylarda ön/son kayıtlı klip; süren klip varsa o uzatılır
+    std::function<std::string()> clipProvider;
+    if (event.priority >= CLIP_MIN_PRIORITY && clipRecorder) {
+        clipProvider = [this, &event]() {
+            return clipRecorder->trigger(std::to_string(event.id), event.timestamp);
+        };
+    }
+    
+    notificationSystem->sendNotification({
+        type,
+        EventBus::describe(event),
+        AlertRing::formatTimestamp(event.wallTime),
+        event.priority,
+        "",  // imageUrl
+        EventBus::coalesceKey(event),
+        imageProvider,
+        "",  // clipUrl
+        clipProvider
+    });
+}
+
+std::string FastyDetector::saveSnapshot(const cv::Mat& frame, const std::string& prefix) {
+    return snapshotEncoder ? snapshotEncoder->submit(frame, prefix) : "";
 }
 
 void FastyDetector::setDetectionArea(const cv::Rect& area) {
@@ -599,8 +694,24 @@ void FastyDetector::enableFaceRecognition(bool enable) {
     addAlert(enable ? "Yüz tanıma aktif" : "Yüz tanıma deaktif", 2);
 }
 
+void FastyDetector::addKnownFace(const cv::Mat& faceImage, const std::string& personName) {
+    if (faceImage.empty() || personName.empty()) return;
+    
+    try {
+        if (faceGallery->enroll(faceImage, personName) < 0) {
+            addAlert("Yüz kaydedilemedi: " + personName, 3);
+            return;
+        }
+        faceGallery->flush();
+        addAlert("Yüz kaydedildi: " + personName, 2);
+    } catch (const cv::Exception& e) {
+        addAlert("Yüz kayıt hatası: " + std::string(e.what()), 3);
+    }
+}
+
 void FastyDetector::updateSettings(const Settings& newSettings) {
     settings = newSettings;
+    resizeAlerts(settings.maxAlerts);
 }
 
 FastyDetector::Settings FastyDetector::getSettings() const {
@@ -609,15 +720,25 @@ FastyDetector::Settings FastyDetector::getSettings() const {
 
 void FastyDetector::resetSettings() {
     settings = Settings();
+    resizeAlerts(settings.maxAlerts);
     addAlert("Ayarlar sıfırlandı", 2);
 }
 
 std::vector<FastyDetector::Alert> FastyDetector::getAlerts() const {
-    return std::vector<Alert>(alerts.begin(), alerts.end());
+    std::vector<Alert> result;
+    std::atomic_load(&alerts)->visit([&result](const AlertRing::Entry& entry) {
+        result.push_back({entry.message, entry.priority, entry.timestamp,
+                          entry.location(), entry.imageUrl});
+    });
+    return result;
+}
+
+std::shared_ptr<const AlertRing> FastyDetector::getAlertRing() const {
+    return std::atomic_load(&alerts);
 }
 
 void FastyDetector::clearAlerts() {
-    alerts.clear();
+    std::atomic_load(&alerts)->clear();
 }
 
 int FastyDetector::getCurrentFrame() const {
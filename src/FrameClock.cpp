@@ -0,0 +1,58 @@
+#include "FrameClock.hpp"
+#include <algorithm>
+
+namespace {
+const double DEFAULT_FPS = 30.0;
+}
+
+FrameClock::FrameClock() {
+    reset();
+}
+
+void FrameClock::reset() {
+    current = MediaTime(0);
+    previous = MediaTime(0);
+    lastSourceTime = MediaTime(0);
+    loopOffset = MediaTime(0);
+    frameInterval = MediaTime(1.0 / DEFAULT_FPS);
+    started = false;
+    origin = std::chrono::steady_clock::now();
+}
+
+MediaTime FrameClock::stamp(const cv::VideoCapture& capture, bool isCamera) {
+    double fps = capture.get(cv::CAP_PROP_FPS);
+    if (fps > 0) {
+        frameInterval = MediaTime(1.0 / fps);
+    }
+
+    MediaTime sourceTime;
+    if (isCamera) {
+        // Kamerada yakalama anı
+        sourceTime = std::chrono::steady_clock::now() - origin;
+    } else {
+        double positionMs = capture.get(cv::CAP_PROP_POS_MSEC);
+        if (positionMs > 0) {
+            sourceTime = MediaTime(positionMs / 1000.0);
+        } else {
+            // Bazı arka uçlar POS_MSEC vermez: kare indeksinden türet
+            double frameIndex = capture.get(cv::CAP_PROP_POS_FRAMES);
+            sourceTime = MediaTime(std::max(0.0, frameIndex - 1.0) * frameInterval.count());
+        }
+
+        // Video başa sarıldı: zaman kaldığı yerden devam etsin
+        if (started && sourceTime < lastSourceTime) {
+            loopOffset += lastSourceTime + frameInterval;
+        }
+    }
+    lastSourceTime = sourceTime;
+
+    MediaTime stampTime = sourceTime + loopOffset;
+    if (started && stampTime <= current) {
+        stampTime = current + frameInterval;
+    }
+
+    previous = started ? current : stampTime - frameInterval;
+    current = stampTime;
+    started = true;
+    return current;
+}
\ No newline at end of file
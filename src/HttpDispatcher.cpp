@@ -0,0 +1,137 @@
+#include "HttpDispatcher.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+HttpDispatcher::HttpDispatcher(int maxInFlight, long timeoutSeconds)
+    : maxInFlight(std::max(1, maxInFlight)), timeoutSeconds(timeoutSeconds),
+      inFlight(0), jsonHeaders(nullptr), formHeaders(nullptr) {
+    multi = curl_multi_init();
+    if (!multi) {
+        throw std::runtime_error("CURL multi initialization failed");
+    }
+
+    // Uç nokta başına en fazla maxInFlight bağlantı; önbellek hepsini tutabilsin
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(this->maxInFlight));
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(this->maxInFlight * 4));
+
+    jsonHeaders = curl_slist_append(jsonHeaders, "Content-Type: application/json");
+    formHeaders = curl_slist_append(formHeaders, "Content-Type: application/x-www-form-urlencoded");
+}
+
+HttpDispatcher::~HttpDispatcher() {
+    // runUntilIdle her zaman boşta döner; uçuşta tutamaç kalmaz
+    for (CURL* handle : idleHandles) {
+        curl_easy_cleanup(handle);
+    }
+    curl_multi_cleanup(multi);
+    curl_slist_free_all(jsonHeaders);
+    curl_slist_free_all(formHeaders);
+}
+
+void HttpDispatcher::setCompletionCallback(std::function<void(const Result&)> callback) {
+    onComplete = std::move(callback);
+}
+
+size_t HttpDispatcher::DiscardCallback([[maybe_unused]] void* contents, size_t size,
+                                       size_t nmemb, [[maybe_unused]] void* userp) {
+    return size * nmemb;
+}
+
+CURL* HttpDispatcher::acquireHandle() {
+    if (!idleHandles.empty()) {
+        CURL* handle = idleHandles.back();
+        idleHandles.pop_back();
+        return handle;
+    }
+
+    CURL* handle = curl_easy_init();
+    if (!handle) return nullptr;
+
+    // İstekten bağımsız seçenekler tutamaç ömrü boyunca bir kez ayarlanır
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 5L);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT, timeoutSeconds);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, DiscardCallback);
+    return handle;
+}
+
+void HttpDispatcher::post(const std::string& url, std::string body, ContentType type, long tag) {
+    auto request = std::make_unique<Request>();
+    request->url = url;
+    request->body = std::move(body);
+    request->type = type;
+    request->tag = tag;
+    request->queued = Clock::now();
+    waiting.push_back(std::move(request));
+}
+
+void HttpDispatcher::startWaiting() {
+    while (!waiting.empty() && inFlight < maxInFlight) {
+        CURL* handle = acquireHandle();
+        if (!handle) return;
+
+        std::unique_ptr<Request> request = std::move(waiting.front());
+        waiting.pop_front();
+        request->handle = handle;
+
+        curl_easy_setopt(handle, CURLOPT_URL, request->url.c_str());
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request->body.data());
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, static_cast<long>(request->body.size()));
+        curl_easy_setopt(handle, CURLOPT_HTTPHEADER,
+                         request->type == ContentType::JSON ? jsonHeaders : formHeaders);
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, request.get());
+
+        curl_multi_add_handle(multi, handle);
+        request.release();  // Tamamlanınca collectCompleted siler
+        inFlight++;
+    }
+}
+
+void HttpDispatcher::collectCompleted() {
+    CURLMsg* message;
+    int remaining = 0;
+    while ((message = curl_multi_info_read(multi, &remaining))) {
+        if (message->msg != CURLMSG_DONE) continue;
+
+        CURL* handle = message->easy_handle;
+        Request* raw = nullptr;
+        curl_easy_getinfo(handle, CURLINFO_PRIVATE, &raw);
+        std::unique_ptr<Request> request(raw);
+
+        Result result;
+        result.url = request->url;
+        result.tag = request->tag;
+        result.status = 0;
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &result.status);
+        result.ok = message->data.result == CURLE_OK &&
+                    result.status >= 200 && result.status < 300;
+        result.seconds = std::chrono::duration<double>(Clock::now() - request->queued).count();
+
+        stats.completed++;
+        if (!result.ok) stats.failed++;
+        stats.totalSeconds += result.seconds;
+        stats.maxSeconds = std::max(stats.maxSeconds, result.seconds);
+
+        curl_multi_remove_handle(multi, handle);
+        idleHandles.push_back(handle);
+        inFlight--;
+
+        if (onComplete) onComplete(result);
+    }
+}
+
+void HttpDispatcher::runUntilIdle() {
+    while (!waiting.empty() || inFlight > 0) {
+        startWaiting();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+        collectCompleted();
+
+        if (running > 0) {
+            curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+        }
+    }
+}
\ No newline at end of file
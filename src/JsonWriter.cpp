@@ -0,0 +1,122 @@
+#include "JsonWriter.hpp"
+#include <cmath>
+#include <cstdio>
+
+JsonWriter::JsonWriter(size_t reserveBytes) : needComma(false) {
+    buffer.reserve(reserveBytes);
+}
+
+void JsonWriter::clear() {
+    buffer.clear();
+    needComma = false;
+}
+
+std::string JsonWriter::release() {
+    std::string out = std::move(buffer);
+    clear();
+    return out;
+}
+
+void JsonWriter::separate() {
+    if (needComma) buffer.push_back(',');
+    needComma = true;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    buffer.push_back('{');
+    needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    buffer.push_back('}');
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    buffer.push_back('[');
+    needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    buffer.push_back(']');
+    needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const std::string& name) {
+    separate();
+    appendEscaped(buffer, name);
+    buffer.push_back(':');
+    needComma = false;  // Değer anahtardan sonra virgülsüz gelir
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const std::string& text) {
+    separate();
+    appendEscaped(buffer, text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* text) {
+    return value(std::string(text ? text : ""));
+}
+
+JsonWriter& JsonWriter::value(int64_t number) {
+    separate();
+    buffer += std::to_string(number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    separate();
+    if (!std::isfinite(number)) {
+        buffer += "null";  // JSON'da NaN/Inf yok
+        return *this;
+    }
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%.17g", number);
+    buffer.append(text, length);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    buffer += flag ? "true" : "false";
+    return *this;
+}
+
+void JsonWriter::appendEscaped(std::string& out, const std::string& text) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out.push_back('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        // Kaçış gerektirmeyen aralığı tek seferde kopyala
+        out.append(text, runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out.push_back(HEX[c >> 4]);
+                out.push_back(HEX[c & 0xF]);
+        }
+    }
+    out.append(text, runStart, text.size() - runStart);
+    out.push_back('"');
+}
\ No newline at end of file
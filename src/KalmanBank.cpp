@@ -0,0 +1,126 @@
+#include "KalmanBank.hpp"
+#include <cmath>
+
+KalmanBank::KalmanBank()
+    : processNoise(400.0f), measurementNoise(16.0f),
+      initialVelocityVariance(10000.0f), sizeSmoothing(0.5f) {
+}
+
+int KalmanBank::add(const cv::Rect& box) {
+    cx.push_back(box.x + box.width * 0.5f);
+    cy.push_back(box.y + box.height * 0.5f);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    width.push_back(static_cast<float>(box.width));
+    height.push_back(static_cast<float>(box.height));
+    p00.push_back(measurementNoise);
+    p01.push_back(0.0f);
+    p11.push_back(initialVelocityVariance);
+    return static_cast<int>(cx.size()) - 1;
+}
+
+void KalmanBank::swapRemove(int index) {
+    size_t last = cx.size() - 1;
+    for (auto* column : {&cx, &cy, &vx, &vy, &width, &height, &p00, &p01, &p11}) {
+        (*column)[index] = (*column)[last];
+        column->pop_back();
+    }
+}
+
+void KalmanBank::clear() {
+    for (auto* column : {&cx, &cy, &vx, &vy, &width, &height, &p00, &p01, &p11}) {
+        column->clear();
+    }
+}
+
+void KalmanBank::predict(float dt) {
+    const size_t n = cx.size();
+    const float dt2 = dt * dt;
+    const float q00 = processNoise * dt2 * dt / 3.0f;
+    const float q01 = processNoise * dt2 * 0.5f;
+    const float q11 = processNoise * dt;
+
+    float* px = cx.data();
+    float* py = cy.data();
+    const float* pvx = vx.data();
+    const float* pvy = vy.data();
+    float* a = p00.data();
+    float* b = p01.data();
+    float* c = p11.data();
+
+    // x' = F x,  P' = F P F^T + Q,  F = [1 dt; 0 1]
+    for (size_t i = 0; i < n; i++) {
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        a[i] += 2.0f * dt * b[i] + dt2 * c[i] + q00;
+        b[i] += dt * c[i] + q01;
+        c[i] += q11;
+    }
+}
+
+void KalmanBank::hold(int index) {
+    vx[index] = 0.0f;
+    vy[index] = 0.0f;
+    p01[index] = 0.0f;
+    p11[index] = initialVelocityVariance;
+}
+
+void KalmanBank::correct(int index, const cv::Rect& measurement) {
+    const float mx = measurement.x + measurement.width * 0.5f;
+    const float my = measurement.y + measurement.height * 0.5f;
+
+    // Kazanç: K = P H^T / (H P H^T + R),  H = [1 0]
+    const float s = p00[index] + measurementNoise;
+    const float k0 = p00[index] / s;
+    const float k1 = p01[index] / s;
+
+    const float ix = mx - cx[index];
+    const float iy = my - cy[index];
+    cx[index] += k0 * ix;
+    cy[index] += k0 * iy;
+    vx[index] += k1 * ix;
+    vy[index] += k1 * iy;
+
+    // P = (I - K H) P
+    const float a = p00[index];
+    const float b = p01[index];
+    p00[index] = (1.0f - k0) * a;
+    p01[index] = (1.0f - k0) * b;
+    p11[index] -= k1 * b;
+
+    width[index] += sizeSmoothing * (measurement.width - width[index]);
+    height[index] += sizeSmoothing * (measurement.height - height[index]);
+}
+
+cv::Rect KalmanBank::predictedBox(int index) const {
+    return cv::Rect(static_cast<int>(std::lround(cx[index] - width[index] * 0.5f)),
+                    static_cast<int>(std::lround(cy[index] - height[index] * 0.5f)),
+                    static_cast<int>(std::lround(width[index])),
+                    static_cast<int>(std::lround(height[index])));
+}
+
+std::vector<cv::Point2f> KalmanBank::extrapolate(int index, float dt, int steps) const {
+    std::vector<cv::Point2f> points;
+    points.reserve(steps);
+    for (int k = 1; k <= steps; k++) {
+        points.emplace_back(cx[index] + vx[index] * dt * k,
+                            cy[index] + vy[index] * dt * k);
+    }
+    return points;
+}
+
+void KalmanBank::project(const std::vector<int>& indices, float horizon,
+                         std::vector<cv::Point2f>& from, std::vector<cv::Point2f>& to) const {
+    from.resize(indices.size());
+    to.resize(indices.size());
+    for (size_t k = 0; k < indices.size(); k++) {
+        const int i = indices[k];
+        from[k] = cv::Point2f(cx[i], cy[i]);
+        to[k] = cv::Point2f(cx[i] + vx[i] * horizon, cy[i] + vy[i] * horizon);
+    }
+}
+
+void KalmanBank::setNoise(float process, float measurement) {
+    processNoise = process;
+    measurementNoise = measurement;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "LabelCache.hpp"
+#include <algorithm>
+
+namespace {
+template <typename T>
+void appendRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+uint32_t packColor(const cv::Scalar& color) {
+    auto channel = [](double v) {
+        return static_cast<uint32_t>(std::min(255.0, std::max(0.0, v)));
+    };
+    return channel(color[0]) | (channel(color[1]) << 8) | (channel(color[2]) << 16);
+}
+}
+
+LabelCache::LabelCache(size_t capacity)
+    : capacity(std::max<size_t>(1, capacity)) {
+}
+
+void LabelCache::buildKey(const std::string& text, const Style& style) {
+    keyBuffer.assign(text);
+    keyBuffer.push_back('\0');
+    appendRaw(keyBuffer, style.fontFace);
+    appendRaw(keyBuffer, style.scale);
+    appendRaw(keyBuffer, style.thickness);
+    appendRaw(keyBuffer, packColor(style.color));
+    appendRaw(keyBuffer, packColor(style.background));
+}
+
+const LabelCache::Label& LabelCache::get(const std::string& text, const Style& style) {
+    buildKey(text, style);
+    
+    auto it = index.find(keyBuffer);
+    if (it != index.end()) {
+        stats.hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+    stats.misses++;
+    
+    Label label;
+    label.textSize = cv::getTextSize(text, style.fontFace, style.scale,
+                                     style.thickness, &label.baseline);
+    cv::Size spriteSize(label.textSize.width + 2 * PADDING,
+                        label.textSize.height + label.baseline + 2 * PADDING);
+    label.sprite = cv::Mat(spriteSize, CV_8UC3, style.background);
+    cv::putText(label.sprite, text, cv::Point(PADDING, PADDING + label.textSize.height),
+                style.fontFace, style.scale, style.color, style.thickness);
+    
+    stats.bytes += label.sprite.total() * label.sprite.elemSize();
+    entries.emplace_front(keyBuffer, std::move(label));
+    index.emplace(keyBuffer, entries.begin());
+    evict();
+    return entries.front().second;
+}
+
+void LabelCache::blit(cv::Mat& frame, const Label& label, const cv::Point& origin) {
+    if (label.sprite.empty() || frame.type() != label.sprite.type()) return;
+    
+    cv::Rect target(origin.x - PADDING, origin.y - label.textSize.height - PADDING,
+                    label.sprite.cols, label.sprite.rows);
+    cv::Rect visible = target & cv::Rect(0, 0, frame.cols, frame.rows);
+    if (visible.area() == 0) return;
+    
+    cv::Rect source(visible.x - target.x, visible.y - target.y, visible.width, visible.height);
+    cv::Mat destination = frame(visible);
+    label.sprite(source).copyTo(destination);
+}
+
+void LabelCache::evict() {
+    // En az kullanılan sondadır; yeni eklenen (baş) hiçbir zaman çıkarılmaz
+    while (entries.size() > capacity) {
+        const Entry& last = entries.back();
+        stats.bytes -= last.second.sprite.total() * last.second.sprite.elemSize();
+        index.erase(last.first);
+        entries.pop_back();
+        stats.evictions++;
+    }
+}
+
+void LabelCache::setCapacity(size_t newCapacity) {
+    capacity = std::max<size_t>(1, newCapacity);
+    evict();
+}
+
+void LabelCache::clear() {
+    entries.clear();
+    index.clear();
+    stats.bytes = 0;
+}
+
+LabelCache::Stats LabelCache::getStats() const {
+    Stats result = stats;
+    result.entries = entries.size();
+    return result;
+}
\ No newline at end of file
@@ -96,6 +96,7 @@ void MenuSystem::setupShortcuts() {
 void MenuSystem::show(MenuType type) {
     currentMenu = type;
     isVisible = true;
+    revision++;
     cv::Mat emptyFrame;
     drawMenu(emptyFrame, menus[currentMenu]);
 }
@@ -103,43 +104,55 @@ void MenuSystem::show(MenuType type) {
 void MenuSystem::draw(cv::Mat& frame) {
     if (!isVisible) return;
 
-    // Yarı saydam siyah overlay
-    cv::Mat overlay;
-    frame.copyTo(overlay);
-    cv::rectangle(overlay, cv::Point(0, 0), 
-                 cv::Point(frame.cols, frame.rows),
-                 cv::Scalar(0, 0, 0), cv::FILLED);
-    cv::addWeighted(overlay, 0.5, frame, 0.5, 0, frame);
+    // Yarı saydam siyah overlay (ek kopya olmadan: 0.5 * frame)
+    frame.convertTo(frame, -1, 0.5);
 
     // Menüyü çiz
-    drawMenu(frame, menus[currentMenu]);
+    drawItems(frame, menus[currentMenu], cv::Scalar(255, 255, 255));
+}
+
+void MenuSystem::renderLayer(cv::Mat& canvas) {
+    if (!isVisible) return;
+
+    // Zemin: %50 opak siyah; metin tam opak
+    canvas.setTo(cv::Scalar(0, 0, 0, 128));
+    drawItems(canvas, menus[currentMenu], cv::Scalar(255, 255, 255, 255));
+}
+
+std::string MenuSystem::itemLabel(int key, const MenuItem& item) {
+    std::stringstream ss;
+    ss << "[" << key << "] " << item.text;
+    if (item.isToggle && item.toggleState) {
+        ss << " [" << (*item.toggleState ? "Açık" : "Kapalı") << "]";
+    }
+    if (!item.shortcut.empty()) {
+        ss << " (" << item.shortcut << ")";
+    }
+    return ss.str();
+}
+
+void MenuSystem::drawItems(cv::Mat& frame, const std::map<int, MenuItem>& menu,
+                           const cv::Scalar& color) {
+    int y = 50;
+    for (const auto& [key, item] : menu) {
+        cv::putText(frame, itemLabel(key, item), cv::Point(50, y),
+                   cv::FONT_HERSHEY_SIMPLEX, 0.7, color, 2);
+        y += 40;
+    }
 }
 
 void MenuSystem::drawMenu(const cv::Mat& frame, const std::map<int, MenuItem>& menu) {
     // Terminal'de menüyü göster
     std::cout << "\n=== FASTY AI MENU ===\n\n";
     
-    int y = 50;
     for (const auto& [key, item] : menu) {
-        std::stringstream ss;
-        ss << "[" << key << "] " << item.text;
-        if (item.isToggle && item.toggleState) {
-            ss << " [" << (*item.toggleState ? "Açık" : "Kapalı") << "]";
-        }
-        if (!item.shortcut.empty()) {
-            ss << " (" << item.shortcut << ")";
-        }
-        
-        // Terminal'e yaz
-        std::cout << ss.str() << "\n";
-        
-        // Frame boş değilse frame'e çiz
-        if (!frame.empty()) {
-            cv::putText(frame, ss.str(), cv::Point(50, y),
-                       cv::FONT_HERSHEY_SIMPLEX, 0.7,
-                       cv::Scalar(255, 255, 255), 2);
-            y += 40;
-        }
+        std::cout << itemLabel(key, item) << "\n";
+    }
+    
+    // Frame boş değilse frame'e çiz
+    if (!frame.empty()) {
+        cv::Mat target = frame;
+        drawItems(target, menu, cv::Scalar(255, 255, 255));
     }
     
     std::cout << "\nSeçiminiz: ";
@@ -150,6 +163,7 @@ void MenuSystem::handleInput(int key) {
     
     // ESC tuşu kontrolü
     if (key == 27) {
+        revision++;
         if (currentMenu == MenuType::MAIN) {
             isVisible = false;
         } else {
@@ -167,6 +181,7 @@ void MenuSystem::handleInput(int key) {
         const auto& item = it->second;
         if (item.isToggle && item.toggleState) {
             *item.toggleState = !*item.toggleState;
+            revision++;
             showNotification(item.text + ": " + 
                            (*item.toggleState ? "Açık" : "Kapalı"));
         }
@@ -178,6 +193,7 @@ bool MenuSystem::handleShortcut(char key) {
     auto it = shortcuts.find(key);
     if (it != shortcuts.end()) {
         it->second();
+        revision++;
         return true;
     }
     return false;
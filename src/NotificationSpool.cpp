@@ -0,0 +1,303 @@
+#include "NotificationSpool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+const char* SEGMENT_PREFIX = "spool-";
+const char* SEGMENT_SUFFIX = ".log";
+const char* CHECKPOINT_FILE = "checkpoint";
+const char* DEAD_LETTER_FILE = "dead-letter.log";
+const size_t RECORD_HEADER = 16;
+
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+uint32_t crc32(const char* data, size_t length, uint32_t crc = 0) {
+    const auto& table = crcTable();
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+template <typename T>
+void appendRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readRaw(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) return false;
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+}
+
+NotificationSpool::NotificationSpool()
+    : segmentFd(-1), segmentSize(0), nextSequence(1), checkpoint(0),
+      checkpointDirty(false) {
+}
+
+NotificationSpool::~NotificationSpool() {
+    close();
+}
+
+std::string NotificationSpool::segmentPath(uint64_t firstSequence) const {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s%020llu%s", SEGMENT_PREFIX,
+                  static_cast<unsigned long long>(firstSequence), SEGMENT_SUFFIX);
+    return (fs::path(directory) / name).string();
+}
+
+bool NotificationSpool::open(const std::string& dir) {
+    close();
+    directory = dir;
+
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) return false;
+
+    // Checkpoint, ardından "a <sıra>" sırasız onay ve "m <sıra> <bayrak>" işaret
+    // satırları (eski dosyalarda yalnızca checkpoint bulunur)
+    checkpoint = 0;
+    acknowledged.clear();
+    marks.clear();
+    std::ifstream checkpointIn(fs::path(directory) / CHECKPOINT_FILE);
+    if (checkpointIn) {
+        unsigned long long value = 0;
+        if (checkpointIn >> value) checkpoint = value;
+        std::string kind;
+        while (checkpointIn >> kind >> value) {
+            if (kind == "a") {
+                acknowledged.insert(value);
+            } else if (kind == "m") {
+                unsigned flags = 0;
+                if (!(checkpointIn >> flags)) break;
+                marks[value] = static_cast<uint8_t>(flags);
+            }
+        }
+    }
+
+    // Mevcut segmentler
+    segmentStarts.clear();
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind(SEGMENT_PREFIX, 0) != 0 || entry.path().extension() != SEGMENT_SUFFIX) {
+            continue;
+        }
+        segmentStarts.push_back(std::stoull(name.substr(std::strlen(SEGMENT_PREFIX))));
+    }
+    std::sort(segmentStarts.begin(), segmentStarts.end());
+
+    // Sıradaki numara: son segmentin son geçerli kaydından sonra
+    nextSequence = checkpoint + 1;
+    if (!segmentStarts.empty()) {
+        std::vector<Record> ignored;
+        uint64_t last = 0;
+        readSegment(segmentStarts.back(), ignored, &last);
+        nextSequence = std::max(nextSequence, std::max(last + 1, segmentStarts.back()));
+    }
+
+    checkpointDirty = false;
+
+    // Yarım kalmış kuyruğa ekleme yapılmaz: her açılış yeni segment başlatır
+    return startSegment();
+}
+
+void NotificationSpool::close() {
+    if (segmentFd >= 0) {
+        commit();
+        ::close(segmentFd);
+        segmentFd = -1;
+    }
+}
+
+bool NotificationSpool::startSegment() {
+    if (segmentFd >= 0) {
+        ::fdatasync(segmentFd);
+        ::close(segmentFd);
+        segmentFd = -1;
+    }
+
+    // Boş son segment yeniden kullanılır (aynı ilk numara)
+    if (!segmentStarts.empty() && segmentStarts.back() == nextSequence) {
+        segmentStarts.pop_back();
+    }
+
+    segmentFd = ::open(segmentPath(nextSequence).c_str(),
+                       O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (segmentFd < 0) return false;
+
+    segmentStarts.push_back(nextSequence);
+    segmentSize = 0;
+    return true;
+}
+
+uint64_t NotificationSpool::append(const std::vector<std::string>& payloads) {
+    if (segmentFd < 0 || payloads.empty()) return 0;
+
+    const uint64_t first = nextSequence;
+    writeBuffer.clear();
+    for (size_t i = 0; i < payloads.size(); i++) {
+        encodeRecord(first + i, payloads[i]);
+    }
+
+    // Tek write + tek fdatasync: tüm tur aynı anda kalıcı olur
+    if (!writeAll(segmentFd, writeBuffer.data(), writeBuffer.size()) ||
+        ::fdatasync(segmentFd) != 0) {
+        return 0;
+    }
+
+    nextSequence += payloads.size();
+    segmentSize += writeBuffer.size();
+    if (segmentSize >= SEGMENT_BYTES) {
+        startSegment();
+    }
+    return first;
+}
+
+void NotificationSpool::encodeRecord(uint64_t sequence, const std::string& payload) {
+    uint32_t crc = crc32(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+    crc = crc32(payload.data(), payload.size(), crc);
+
+    appendRaw(writeBuffer, static_cast<uint32_t>(payload.size()));
+    appendRaw(writeBuffer, crc);
+    appendRaw(writeBuffer, sequence);
+    writeBuffer += payload;
+}
+
+void NotificationSpool::acknowledge(uint64_t sequence) {
+    if (sequence <= checkpoint) return;
+    acknowledged.insert(sequence);
+    marks.erase(sequence);
+    checkpointDirty = true;
+
+    // Kesintisiz onaylanan önek checkpoint'e katılır
+    auto it = acknowledged.begin();
+    while (it != acknowledged.end() && *it == checkpoint + 1) {
+        checkpoint++;
+        it = acknowledged.erase(it);
+    }
+}
+
+void NotificationSpool::mark(uint64_t sequence, uint8_t flags) {
+    if (sequence <= checkpoint || acknowledged.count(sequence)) return;
+    uint8_t& current = marks[sequence];
+    if ((current | flags) == current) return;
+    current |= flags;
+    checkpointDirty = true;
+}
+
+bool NotificationSpool::deadLetter(uint64_t sequence, const std::string& payload) {
+    if (directory.empty()) return false;
+
+    int fd = ::open((fs::path(directory) / DEAD_LETTER_FILE).c_str(),
+                    O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+    writeBuffer.clear();
+    encodeRecord(sequence, payload);
+    bool ok = writeAll(fd, writeBuffer.data(), writeBuffer.size()) && ::fdatasync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+bool NotificationSpool::commit() {
+    if (!checkpointDirty || directory.empty()) return true;
+
+    // Geçici dosya + rename: checkpoint her zaman bütün okunur
+    fs::path target = fs::path(directory) / CHECKPOINT_FILE;
+    fs::path temp = target;
+    temp += ".tmp";
+
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    std::string text = std::to_string(checkpoint) + "\n";
+    for (uint64_t sequence : acknowledged) {
+        text += "a " + std::to_string(sequence) + "\n";
+    }
+    for (const auto& [sequence, flags] : marks) {
+        text += "m " + std::to_string(sequence) + " " + std::to_string(flags) + "\n";
+    }
+    bool ok = writeAll(fd, text.data(), text.size()) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || std::rename(temp.c_str(), target.c_str()) != 0) return false;
+    checkpointDirty = false;
+
+    // Son kaydı checkpoint'te veya gerisinde kalan eski segmentleri sil
+    while (segmentStarts.size() > 1 && segmentStarts[1] - 1 <= checkpoint) {
+        std::error_code error;
+        fs::remove(segmentPath(segmentStarts.front()), error);
+        segmentStarts.erase(segmentStarts.begin());
+    }
+    return true;
+}
+
+void NotificationSpool::readSegment(uint64_t firstSequence, std::vector<Record>& out,
+                                    uint64_t* lastSequence) const {
+    std::ifstream in(segmentPath(firstSequence), std::ios::binary);
+    if (!in) return;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    while (offset + RECORD_HEADER <= data.size()) {
+        uint32_t length = readRaw<uint32_t>(data.data() + offset);
+        uint32_t crc = readRaw<uint32_t>(data.data() + offset + 4);
+        uint64_t sequence = readRaw<uint64_t>(data.data() + offset + 8);
+        if (offset + RECORD_HEADER + length > data.size()) break;
+
+        const char* payload = data.data() + offset + RECORD_HEADER;
+        uint32_t actual = crc32(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+        actual = crc32(payload, length, actual);
+        if (actual != crc) break;  // Yarım yazılmış kuyruk
+
+        if (lastSequence) *lastSequence = sequence;
+        if (sequence > checkpoint && !acknowledged.count(sequence)) {
+            auto mark = marks.find(sequence);
+            out.push_back({sequence, std::string(payload, length),
+                           mark != marks.end() ? mark->second : uint8_t(0)});
+        }
+        offset += RECORD_HEADER + length;
+    }
+}
+
+std::vector<NotificationSpool::Record> NotificationSpool::readUnacknowledged() const {
+    std::vector<Record> records;
+    for (uint64_t first : segmentStarts) {
+        readSegment(first, records, nullptr);
+    }
+    return records;
+}
+
+uint64_t NotificationSpool::unacknowledgedCount() const {
+    return nextSequence - 1 - checkpoint - acknowledged.size();
+}
\ No newline at end of file
@@ -1,10 +1,84 @@
 #include "NotificationSystem.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
 #include <sstream>
+#include <stdexcept>
 #include <ctime>
-#include <thread>
-#include <vector>
 
-NotificationSystem::NotificationSystem() : minPriority(0) {
+namespace {
+const char* PUSHOVER_URL = "https://api.pushover.net/1/messages.json";
+
+// SMTP tutamacının önceki isteğin seçeneklerini temizle; zaman aşımı
+// dispatcher'ı kilitlemesin
+void resetHandle(CURL* curl) {
+    curl_easy_reset(curl);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
+}
+
+// Spool kaydı: [tip:u8][öncelik:i32] + (uzunluk:u32, bayt) x 5 dizgi
+// (klip bağlantısı sonradan eklendi; 4 dizgili eski kayıtlar da okunur)
+void encodeNotification(const NotificationSystem::Notification& notification, std::string& out) {
+    out.clear();
+    out.push_back(static_cast<char>(notification.type));
+    int32_t priority = notification.priority;
+    out.append(reinterpret_cast<const char*>(&priority), sizeof(priority));
+    for (const std::string* field : {&notification.message, &notification.timestamp,
+                                     &notification.imageUrl, &notification.coalesceKey,
+                                     &notification.clipUrl}) {
+        uint32_t length = static_cast<uint32_t>(field->size());
+        out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        out += *field;
+    }
+}
+
+bool decodeNotification(const std::string& data, NotificationSystem::Notification& notification) {
+    size_t offset = 1 + sizeof(int32_t);
+    if (data.size() < offset) return false;
+    notification.type = static_cast<NotificationSystem::NotificationType>(data[0]);
+    int32_t priority;
+    std::memcpy(&priority, data.data() + 1, sizeof(priority));
+    notification.priority = priority;
+
+    notification.clipUrl.clear();
+    for (std::string* field : {&notification.message, &notification.timestamp,
+                               &notification.imageUrl, &notification.coalesceKey,
+                               &notification.clipUrl}) {
+        if (field == &notification.clipUrl && offset == data.size()) break;
+        uint32_t length;
+        if (offset + sizeof(length) > data.size()) return false;
+        std::memcpy(&length, data.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (offset + length > data.size()) return false;
+        field->assign(data, offset, length);
+        offset += length;
+    }
+    return true;
+}
+
+// application/x-www-form-urlencoded değer kodlaması
+void appendUrlEncoded(std::string& out, const std::string& text) {
+    static const char HEX[] = "0123456789ABCDEF";
+    for (unsigned char c : text) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out.push_back(static_cast<char>(c));
+        } else {
+            out.push_back('%');
+            out.push_back(HEX[c >> 4]);
+            out.push_back(HEX[c & 0xF]);
+        }
+    }
+}
+}
+
+NotificationSystem::NotificationSystem()
+    : stopRequested(false), drainOnStop(true), droppedCount(0),
+      batchWebhooks(false), maxBatchSize(50), minPriority(0),
+      http(MAX_IN_FLIGHT), json(4096), backlogSize(0), pendingCount(0),
+      deadLetterCount(0), emailStop(false) {
     curl = curl_easy_init();
     if (!curl) {
         throw std::runtime_error("CURL initialization failed");
@@ -14,9 +88,34 @@ NotificationSystem::NotificationSystem() : minPriority(0) {
     for (int i = 0; i <= static_cast<int>(NotificationType::SYSTEM_STATUS); i++) {
         enabledTypes[static_cast<NotificationType>(i)] = true;
     }
+    
+    // Başarısız istekler tur içindeki bildirim indeksi ve kanalla işaretlenir.
+    // 4xx (408 ve 429 hariç) kalıcıdır: aynı istek tekrar denense de reddedilir
+    http.setCompletionCallback([this](const HttpDispatcher::Result& result) {
+        if (result.ok) return;
+        bool permanent = result.status >= 400 && result.status < 500 &&
+                         result.status != 408 && result.status != 429;
+        auto fail = [&](size_t index, uint8_t channel) {
+            roundFailed[index] |= channel;
+            if (permanent) roundPermanent[index] |= channel;
+        };
+        if (result.tag == BATCH_TAG) {
+            for (size_t i = 0; i < roundFailed.size(); i++) {
+                if (roundSent[i] & CHANNEL_WEBHOOK) fail(i, CHANNEL_WEBHOOK);
+            }
+        } else if (result.tag >= 0) {
+            size_t index = static_cast<size_t>(result.tag / CHANNEL_TAGS);
+            uint8_t channel = result.tag % CHANNEL_TAGS == 0 ? CHANNEL_PUSHOVER : CHANNEL_WEBHOOK;
+            if (index < roundFailed.size()) fail(index, channel);
+        }
+    });
+    
+    dispatcher = std::thread(&NotificationSystem::processNotificationQueue, this);
+    emailWorker = std::thread(&NotificationSystem::processEmailQueue, this);
 }
 
 NotificationSystem::~NotificationSystem() {
+    shutdown(true);
     if (curl) {
         curl_easy_cleanup(curl);
     }
@@ -25,85 +124,432 @@ NotificationSystem::~NotificationSystem() {
 void NotificationSystem::initialize(const std::string& apiKey, 
                                   const std::string& webhookUrl,
                                   const std::string& pushoverToken) {
+    std::lock_guard<std::mutex> lock(configMutex);
     this->apiKey = apiKey;
     this->webhookUrl = webhookUrl;
     this->pushoverToken = pushoverToken;
 }
 
-void NotificationSystem::sendNotification(const Notification& notification) {
-    // Öncelik ve tip kontrolü
-    if (notification.priority < minPriority || 
-        !enabledTypes[notification.type]) {
-        return;
+int NotificationSystem::laneFor(int priority) {
+    if (priority >= 5) return 0;
+    if (priority >= 3) return 1;
+    return 2;
+}
+
+bool NotificationSystem::sendNotification(const Notification& notification) {
+    // Öncelik kontrolü (kilitsiz)
+    if (notification.priority < minPriority) {
+        return false;
     }
     
     {
         std::lock_guard<std::mutex> lock(queueMutex);
-        notificationQueue.push(notification);
+        if (stopRequested || !enabledTypes[notification.type]) {
+            return false;
+        }
+        
+        // Tekrarlar ve hız sınırını aşanlar özete sayılır, kuyruğa girmez
+        AlertCoalescer::Event event{static_cast<int>(notification.type),
+                                    notification.coalesceKey,
+                                    notification.message,
+                                    notification.timestamp,
+                                    notification.priority};
+        if (!coalescer.admit(event, AlertCoalescer::Clock::now())) {
+            return false;
+        }
+        
+        if (notification.imageProvider || notification.clipProvider) {
+            Notification admitted = notification;
+            if (notification.imageProvider) admitted.imageUrl = notification.imageProvider();
+            if (notification.clipProvider) admitted.clipUrl = notification.clipProvider();
+            admitted.imageProvider = nullptr;
+            admitted.clipProvider = nullptr;
+            enqueueLocked(admitted);
+        } else {
+            enqueueLocked(notification);
+        }
+    }
+    queueCondition.notify_one();
+    return true;
+}
+
+void NotificationSystem::enqueueLocked(const Notification& notification) {
+    // Şerit doluysa en eski bildirim düşürülür; yeni olay daha güncel
+    auto& lane = lanes[laneFor(notification.priority)];
+    if (lane.size() >= LANE_CAPACITY) {
+        lane.pop_front();
+        droppedCount++;
+    }
+    lane.push_back(notification);
+}
+
+void NotificationSystem::enqueueSummariesLocked(bool force) {
+    std::vector<AlertCoalescer::Event> summaries;
+    coalescer.collectSummaries(AlertCoalescer::Clock::now(), summaries, force);
+    for (auto& summary : summaries) {
+        enqueueLocked({
+            static_cast<NotificationType>(summary.type),
+            std::move(summary.message),
+            std::move(summary.timestamp),
+            summary.priority,
+            "",  // imageUrl
+            std::move(summary.key)
+        });
+    }
+}
+
+void NotificationSystem::setCoalescingPolicy(const AlertCoalescer::Policy& policy) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    coalescer.setPolicy(policy);
+}
+
+void NotificationSystem::shutdown(bool drain, std::chrono::milliseconds timeout) {
+    auto deadline = Clock::now() + timeout;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopRequested = true;
+        drainOnStop = drain;
+        drainDeadline = deadline;
     }
+    queueCondition.notify_all();
     
-    // Farklı kanallara gönder
-    if (notification.priority >= 2) {
-        sendPushover(notification.message, notification.priority);
+    if (dispatcher.joinable()) {
+        dispatcher.join();
     }
     
-    sendWebhook(notification);
+    // Dispatcher'ın son turda bıraktığı emailler de aynı süre sınırına tabi
+    {
+        std::lock_guard<std::mutex> lock(emailMutex);
+        emailStop = true;
+        emailDeadline = drain ? deadline : Clock::now();
+    }
+    emailCondition.notify_all();
     
-    // Acil durumlar için email
-    if (notification.priority >= 3) {
-        sendEmail("admin@example.com", "Security Alert", notification.message);
+    if (emailWorker.joinable()) {
+        emailWorker.join();
     }
 }
 
-void NotificationSystem::sendPushover(const std::string& message, int priority) {
-    if (!curl) return;
+void NotificationSystem::setWebhookBatching(bool enable, size_t maxBatch) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    batchWebhooks = enable;
+    maxBatchSize = std::max<size_t>(1, maxBatch);
+}
+
+HttpDispatcher::Stats NotificationSystem::getDeliveryStats() {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    return deliveryStats;
+}
+
+bool NotificationSystem::enableSpool(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(spoolMutex);
+    bool opened = spool.open(directory);
+    if (opened) {
+        // Önceki çalıştırmadan kalanlar dispatcher'ın sonraki turunda yüklenir
+        pendingCount = spool.unacknowledgedCount();
+        queueCondition.notify_one();
+    }
+    return opened;
+}
+
+uint64_t NotificationSystem::getPendingCount() {
+    return pendingCount;
+}
+
+void NotificationSystem::deliverRound(const std::vector<Pending>& round, bool batched) {
+    std::string token, user, url;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        token = pushoverToken;
+        user = apiKey;
+        url = webhookUrl;
+    }
     
-    std::string url = "https://api.pushover.net/1/messages.json";
-    std::string postFields = "token=" + pushoverToken +
-                            "&user=" + apiKey +
-                            "&message=" + curl_easy_escape(curl, message.c_str(), 0) +
-                            "&priority=" + std::to_string(priority);
+    roundSent.assign(round.size(), 0);
+    roundFailed.assign(round.size(), 0);
+    roundPermanent.assign(round.size(), 0);
+    auto needs = [&round](size_t i, uint8_t channel) {
+        return (round[i].delivered & channel) == 0;
+    };
+    
+    // Pushover (öncelik 2+) ve webhook istekleri tek multi turunda eşzamanlı gider;
+    // önceki denemede teslim edilmiş kanal tekrarlanmaz
+    for (size_t i = 0; i < round.size(); i++) {
+        const auto& notification = round[i].notification;
+        if (notification.priority >= 2 && !token.empty() && needs(i, CHANNEL_PUSHOVER)) {
+            queuePushover(token, user, notification.message, notification.priority,
+                          static_cast<long>(i) * CHANNEL_TAGS);
+            roundSent[i] |= CHANNEL_PUSHOVER;
+        }
+    }
     
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postFields.c_str());
+    if (!url.empty()) {
+        if (batched) {
+            json.clear();
+            json.beginArray();
+            for (size_t i = 0; i < round.size(); i++) {
+                if (!needs(i, CHANNEL_WEBHOOK)) continue;
+                writeNotification(round[i].notification);
+                roundSent[i] |= CHANNEL_WEBHOOK;
+            }
+            json.endArray();
+            if (std::any_of(roundSent.begin(), roundSent.end(),
+                            [](uint8_t sent) { return (sent & CHANNEL_WEBHOOK) != 0; })) {
+                http.post(url, json.str(), HttpDispatcher::ContentType::JSON, BATCH_TAG);
+            }
+        } else {
+            for (size_t i = 0; i < round.size(); i++) {
+                if (!needs(i, CHANNEL_WEBHOOK)) continue;
+                json.clear();
+                writeNotification(round[i].notification);
+                http.post(url, json.str(), HttpDispatcher::ContentType::JSON,
+                          static_cast<long>(i) * CHANNEL_TAGS + 1);
+                roundSent[i] |= CHANNEL_WEBHOOK;
+            }
+        }
+    }
     
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-        // Log error
+    // Acil durumlar için email iş parçacığına bırakılır; SMTP turu bekletmez.
+    // Bildirim başına bir kez denenir; sonucu teslim onayına katılmaz
+    for (size_t i = 0; i < round.size(); i++) {
+        if (round[i].notification.priority >= 3 && needs(i, CHANNEL_EMAIL)) {
+            queueEmail(round[i].notification.message);
+        }
+        roundSent[i] |= CHANNEL_EMAIL;
     }
+    
+    http.runUntilIdle();
 }
 
-void NotificationSystem::sendWebhook(const Notification& notification) {
-    if (!curl || webhookUrl.empty()) return;
+void NotificationSystem::completeRound(std::vector<Pending>& round, bool requeue) {
+    // Yeniden denenecekler: kalıcı olmayan hatası olan ve deneme sınırı dolmayanlar.
+    // Kalıcı hata alan kanal dead-letter'a yazılır ve bir daha denenmez.
+    std::vector<char> retry(round.size(), 0);
+    size_t failures = 0;
+    for (size_t i = 0; i < round.size(); i++) {
+        Pending& pending = round[i];
+        pending.delivered |= (roundSent[i] & ~roundFailed[i]) | roundPermanent[i];
+        if (roundPermanent[i]) deadLetter(pending);
+        if ((roundFailed[i] & ~roundPermanent[i]) == 0) continue;
+        failures++;
+        if (pending.attempts + 1 < MAX_ATTEMPTS) {
+            retry[i] = 1;
+        } else if (requeue) {
+            deadLetter(pending);
+        } else {
+            retry[i] = 1;  // Kapanış: spool'da kalır, sonraki çalıştırmada denenir
+        }
+    }
     
-    // JSON oluştur
-    std::stringstream json;
-    json << "{"
-         << "\"type\":\"" << static_cast<int>(notification.type) << "\","
-         << "\"message\":\"" << notification.message << "\","
-         << "\"priority\":" << notification.priority << ","
-         << "\"timestamp\":\"" << notification.timestamp << "\"";
+    {
+        std::lock_guard<std::mutex> lock(spoolMutex);
+        for (size_t i = 0; i < round.size(); i++) {
+            if (round[i].sequence == 0) continue;
+            if (!retry[i]) {
+                spool.acknowledge(round[i].sequence);
+            } else if (round[i].delivered) {
+                // Yeniden başlatmada teslim edilmiş kanallar tekrar gönderilmesin
+                spool.mark(round[i].sequence, round[i].delivered);
+            }
+        }
+        spool.commit();
+    }
     
-    if (!notification.imageUrl.empty()) {
-        json << ",\"image\":\"" << notification.imageUrl << "\"";
+    {
+        std::lock_guard<std::mutex> lock(historyMutex);
+        deliveryStats = http.getStats();
+        for (size_t i = 0; i < round.size(); i++) {
+            if (roundFailed[i]) continue;
+            history.push_back(round[i].notification);
+            if (history.size() > MAX_HISTORY) {
+                history.pop_front();
+            }
+        }
     }
     
-    json << "}";
+    auto now = Clock::now();
+    if (requeue) {
+        // Üstel geri çekilme: 1, 2, 4 ... MAX_BACKOFF_SECONDS saniye
+        for (size_t i = 0; i < round.size(); i++) {
+            if (!retry[i]) continue;
+            Pending& pending = round[i];
+            double delay = std::min(MAX_BACKOFF_SECONDS, std::pow(2.0, pending.attempts));
+            pending.attempts++;
+            pending.due = now + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(delay));
+            pushBacklog(std::move(pending));
+        }
+    }
     
-    std::string jsonStr = json.str();
+    // Tur tamamen başarılıysa uç noktalar ayakta: bekleyen denemeleri öne al
+    if (failures == 0 && !round.empty()) {
+        for (auto& lane : backlog) {
+            for (auto& pending : lane) pending.due = std::min(pending.due, now);
+        }
+    }
+}
+
+void NotificationSystem::deadLetter(const Pending& pending) {
+    deadLetterCount++;
+    if (pending.sequence == 0) return;
     
-    struct curl_slist* headers = NULL;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
+    std::string payload;
+    encodeNotification(pending.notification, payload);
+    std::lock_guard<std::mutex> lock(spoolMutex);
+    spool.deadLetter(pending.sequence, payload);
+}
+
+void NotificationSystem::pushBacklog(Pending pending) {
+    backlog[laneFor(pending.notification.priority)].push_back(std::move(pending));
+    backlogSize++;
     
-    curl_easy_setopt(curl, CURLOPT_URL, webhookUrl.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, jsonStr.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    // Bellek sınırı: en düşük öncelikli en eski kayıt bırakılır. Spool'daysa
+    // kaybolmaz; birikim boşaldığında diskten yeniden yüklenir.
+    if (backlogSize > MAX_BACKLOG) {
+        for (int lane = LANE_COUNT - 1; lane >= 0; lane--) {
+            if (backlog[lane].empty()) continue;
+            if (backlog[lane].front().sequence == 0) droppedCount++;
+            backlog[lane].pop_front();
+            backlogSize--;
+            break;
+        }
+    }
+}
+
+void NotificationSystem::spoolIncoming(std::vector<Notification>& incoming) {
+    auto now = Clock::now();
+    uint64_t first = 0;
     
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
+    {
+        std::lock_guard<std::mutex> lock(spoolMutex);
+        if (spool.isOpen()) {
+            // Birikim boşken diskte onay bekleyen kayıt varsa (önceki çalıştırma ya
+            // da bellekten taşanlar) onları yükle
+            if (backlogSize == 0 && spool.unacknowledgedCount() > 0) {
+                for (auto& record : spool.readUnacknowledged()) {
+                    Notification notification{};
+                    if (decodeNotification(record.payload, notification)) {
+                        pushBacklog({record.sequence, std::move(notification), 0, now,
+                                     record.marks});
+                    } else {
+                        // Bozuk kayıt
+                        spool.deadLetter(record.sequence, record.payload);
+                        spool.acknowledge(record.sequence);
+                        deadLetterCount++;
+                    }
+                }
+            }
+            
+            // Tüm yeni bildirimler tek write + fdatasync ile diske
+            if (!incoming.empty()) {
+                std::vector<std::string> payloads(incoming.size());
+                for (size_t i = 0; i < incoming.size(); i++) {
+                    encodeNotification(incoming[i], payloads[i]);
+                }
+                first = spool.append(payloads);
+            }
+        }
+    }
     
-    if (res != CURLE_OK) {
-        // Log error
+    for (size_t i = 0; i < incoming.size(); i++) {
+        pushBacklog({first ? first + i : 0, std::move(incoming[i]), 0, now});
+    }
+}
+
+bool NotificationSystem::takeRound(std::vector<Pending>& round, size_t limit, bool ignoreDue) {
+    round.clear();
+    auto now = Clock::now();
+    
+    // Öncelik sırasıyla, zamanı gelmiş kayıtlar
+    for (auto& lane : backlog) {
+        for (auto it = lane.begin(); it != lane.end() && round.size() < limit;) {
+            if (ignoreDue || it->due <= now) {
+                round.push_back(std::move(*it));
+                it = lane.erase(it);
+                backlogSize--;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return !round.empty();
+}
+
+bool NotificationSystem::hasDueBacklog() const {
+    auto now = Clock::now();
+    for (const auto& lane : backlog) {
+        for (const auto& pending : lane) {
+            if (pending.due <= now) return true;
+        }
+    }
+    return false;
+}
+
+void NotificationSystem::queuePushover(const std::string& token, const std::string& user,
+                                       const std::string& message, int priority, long tag) {
+    std::string body;
+    body.reserve(64 + message.size() * 3);
+    body += "token=";
+    appendUrlEncoded(body, token);
+    body += "&user=";
+    appendUrlEncoded(body, user);
+    body += "&message=";
+    appendUrlEncoded(body, message);
+    body += "&priority=" + std::to_string(priority);
+    
+    http.post(PUSHOVER_URL, std::move(body), HttpDispatcher::ContentType::FORM, tag);
+}
+
+void NotificationSystem::writeNotification(const Notification& notification) {
+    json.beginObject()
+        .key("type").value(std::to_string(static_cast<int>(notification.type)))
+        .key("message").value(notification.message)
+        .key("priority").value(notification.priority)
+        .key("timestamp").value(notification.timestamp);
+    
+    if (!notification.imageUrl.empty()) {
+        json.key("image").value(notification.imageUrl);
+    }
+    if (!notification.clipUrl.empty()) {
+        json.key("clip").value(notification.clipUrl);
+    }
+    
+    json.endObject();
+}
+
+void NotificationSystem::queueEmail(const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(emailMutex);
+        // SMTP sunucusu yanıt vermiyorsa kuyruk sınırlı kalır; en eski düşer
+        if (emailQueue.size() >= EMAIL_QUEUE_CAPACITY) {
+            emailQueue.pop_front();
+            droppedCount++;
+        }
+        emailQueue.push_back(message);
+    }
+    emailCondition.notify_one();
+}
+
+void NotificationSystem::processEmailQueue() {
+    std::string message;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(emailMutex);
+            emailCondition.wait(lock, [this]() { return emailStop || !emailQueue.empty(); });
+            
+            // Kapanışta süre dolduysa kalanlar bırakılır
+            if (emailStop && (emailQueue.empty() || Clock::now() >= emailDeadline)) {
+                droppedCount += emailQueue.size();
+                emailQueue.clear();
+                return;
+            }
+            
+            message = std::move(emailQueue.front());
+            emailQueue.pop_front();
+        }
+        
+        sendEmail("admin@example.com", "Security Alert", message);
     }
 }
 
@@ -113,6 +559,7 @@ void NotificationSystem::sendEmail(const std::string& recipient,
     if (!curl) return;
     
     // SMTP ayarları
+    resetHandle(curl);
     curl_easy_setopt(curl, CURLOPT_URL, "smtp://smtp.gmail.com:587");
     curl_easy_setopt(curl, CURLOPT_USERNAME, "your-email@gmail.com");
     curl_easy_setopt(curl, CURLOPT_PASSWORD, "your-password");
@@ -140,26 +587,24 @@ void NotificationSystem::sendEmail(const std::string& recipient,
 }
 
 void NotificationSystem::enableNotificationType(NotificationType type, bool enable) {
+    std::lock_guard<std::mutex> lock(queueMutex);
     enabledTypes[type] = enable;
 }
 
 void NotificationSystem::clearNotifications() {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    std::queue<Notification> empty;
-    std::swap(notificationQueue, empty);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (auto& lane : lanes) lane.clear();
+        coalescer.clear();
+    }
+    std::lock_guard<std::mutex> lock(historyMutex);
+    history.clear();
 }
 
 std::vector<NotificationSystem::Notification> NotificationSystem::getRecentNotifications(int count) {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    std::vector<Notification> recent;
-    
-    while (!notificationQueue.empty() && count > 0) {
-        recent.push_back(notificationQueue.front());
-        notificationQueue.pop();
-        count--;
-    }
-    
-    return recent;
+    std::lock_guard<std::mutex> lock(historyMutex);
+    size_t n = std::min(history.size(), static_cast<size_t>(std::max(count, 0)));
+    return std::vector<Notification>(history.end() - n, history.end());
 }
 
 size_t NotificationSystem::WriteCallback(void* contents, size_t size, 
@@ -169,31 +614,68 @@ size_t NotificationSystem::WriteCallback(void* contents, size_t size,
 }
 
 void NotificationSystem::processNotificationQueue() {
+    std::vector<Notification> incoming;
+    std::vector<Pending> round;
+    
     while (true) {
-        std::vector<Notification> notifications;
+        bool batched;
+        bool stopping;
+        size_t limit;
+        Clock::time_point deadline;
+        incoming.clear();
         
         {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            while (!notificationQueue.empty()) {
-                notifications.push_back(notificationQueue.front());
-                notificationQueue.pop();
+            std::unique_lock<std::mutex> lock(queueMutex);
+            auto hasQueued = [this]() {
+                for (const auto& lane : lanes) {
+                    if (!lane.empty()) return true;
+                }
+                return false;
+            };
+            queueCondition.wait_for(lock, std::chrono::milliseconds(SUMMARY_POLL_MS),
+                                    [&]() { return stopRequested || hasQueued() || hasDueBacklog(); });
+            
+            if (stopRequested && !drainOnStop) {
+                return;
+            }
+            
+            // Bastırılan olayların özetleri (kapanışta bekleyenlerin tümü)
+            enqueueSummariesLocked(stopRequested);
+            
+            // Şeritlerin tamamı öncelik sırasıyla birikime alınır
+            for (auto& lane : lanes) {
+                for (auto& notification : lane) incoming.push_back(std::move(notification));
+                lane.clear();
             }
+            
+            stopping = stopRequested;
+            deadline = drainDeadline;
+            batched = batchWebhooks;
+            limit = batched ? maxBatchSize : ROUND_SIZE;
         }
         
-        for (const auto& notification : notifications) {
-            // Her bildirim için işlem yap
-            if (notification.priority >= minPriority) {
-                sendPushover(notification.message, notification.priority);
-                sendWebhook(notification);
-                
-                if (notification.priority >= 3) {
-                    sendEmail("admin@example.com", "High Priority Alert", 
-                             notification.message);
-                }
+        // Diske yazma ve birikim (frame yolunun dışında)
+        spoolIncoming(incoming);
+        
+        if (stopping) {
+            // Kapanış: her bekleyen süre sınırı içinde bir kez denenir;
+            // gönderilemeyenler ya da süreye sığmayanlar spool'da kalır
+            while (Clock::now() < deadline && takeRound(round, limit, true)) {
+                deliverRound(round, batched);
+                completeRound(round, false);
             }
+            return;
         }
         
-        // Her 5 saniyede bir kontrol et
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        // Tur başına tek gönderim: sonraki turda yeni gelen acil bildirim öne geçer
+        if (takeRound(round, limit, false)) {
+            deliverRound(round, batched);
+            completeRound(round, true);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(spoolMutex);
+            pendingCount = spool.isOpen() ? spool.unacknowledgedCount() : backlogSize;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "OverlayCompositor.hpp"
+#include <algorithm>
+
+OverlayCompositor::OverlayCompositor()
+    : headless(false) {
+}
+
+int OverlayCompositor::addLayer(const std::string& name) {
+    Layer layer;
+    layer.name = name;
+    layers.push_back(std::move(layer));
+    return static_cast<int>(layers.size()) - 1;
+}
+
+void OverlayCompositor::setVisible(int layer, bool visible) {
+    if (layer < 0 || layer >= static_cast<int>(layers.size())) return;
+    layers[layer].visible = visible;
+}
+
+void OverlayCompositor::invalidate(int layer) {
+    if (layer < 0 || layer >= static_cast<int>(layers.size())) return;
+    layers[layer].valid = false;
+}
+
+uint64_t OverlayCompositor::sizeKey(const cv::Size& size, uint64_t revision) {
+    uint64_t key = (static_cast<uint64_t>(size.width) << 16) ^ static_cast<uint64_t>(size.height);
+    return key ^ (revision * 0x9E3779B97F4A7C15ull);
+}
+
+void OverlayCompositor::updateLayer(int layer, uint64_t key, const cv::Size& size,
+                                    const Renderer& render) {
+    if (headless || layer < 0 || layer >= static_cast<int>(layers.size())) return;
+    
+    Layer& target = layers[layer];
+    if (target.valid && target.key == key && target.canvas.size() == size) {
+        return;
+    }
+    
+    target.canvas.create(size, CV_8UC4);
+    target.canvas.setTo(cv::Scalar::all(0));
+    render(target.canvas);
+    collectTiles(target);
+    target.key = key;
+    target.valid = true;
+    stats.rasterized++;
+}
+
+void OverlayCompositor::collectTiles(Layer& layer) {
+    layer.tiles.clear();
+    cv::Mat alpha;
+    cv::extractChannel(layer.canvas, alpha, 3);
+    
+    for (int y = 0; y < alpha.rows; y += TILE_SIZE) {
+        int height = std::min(TILE_SIZE, alpha.rows - y);
+        cv::Rect run;
+        for (int x = 0; x < alpha.cols; x += TILE_SIZE) {
+            cv::Rect tile(x, y, std::min(TILE_SIZE, alpha.cols - x), height);
+            if (cv::countNonZero(alpha(tile)) == 0) {
+                if (run.area() > 0) layer.tiles.push_back(run);
+                run = cv::Rect();
+                continue;
+            }
+            // Yan yana dolu karolar tek dikdörtgende birleşir
+            run = run.area() > 0 ? (run | tile) : tile;
+        }
+        if (run.area() > 0) layer.tiles.push_back(run);
+    }
+}
+
+void OverlayCompositor::blend(const cv::Mat& canvas, const cv::Rect& rect, cv::Mat& frame) {
+    for (int y = rect.y; y < rect.y + rect.height; y++) {
+        const uchar* src = canvas.ptr<uchar>(y) + rect.x * 4;
+        uchar* dst = frame.ptr<uchar>(y) + rect.x * 3;
+        for (int x = 0; x < rect.width; x++, src += 4, dst += 3) {
+            int a = src[3];
+            if (a == 0) continue;
+            if (a == 255) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                continue;
+            }
+            int inverse = 255 - a;
+            dst[0] = static_cast<uchar>((src[0] * a + dst[0] * inverse + 127) / 255);
+            dst[1] = static_cast<uchar>((src[1] * a + dst[1] * inverse + 127) / 255);
+            dst[2] = static_cast<uchar>((src[2] * a + dst[2] * inverse + 127) / 255);
+        }
+    }
+}
+
+void OverlayCompositor::compose(cv::Mat& frame) {
+    for (int i = 0; i < static_cast<int>(layers.size()); i++) {
+        compose(i, frame);
+    }
+}
+
+void OverlayCompositor::compose(int index, cv::Mat& frame) {
+    if (headless || frame.empty() || frame.type() != CV_8UC3) return;
+    if (index < 0 || index >= static_cast<int>(layers.size())) return;
+    
+    const Layer& layer = layers[index];
+    if (!layer.visible || !layer.valid || layer.canvas.size() != frame.size()) {
+        return;
+    }
+    // Karolar ayrık; paralel karıştırılabilir
+    cv::parallel_for_(cv::Range(0, static_cast<int>(layer.tiles.size())),
+                      [&layer, &frame](const cv::Range& range) {
+        for (int i = range.start; i < range.end; i++) {
+            blend(layer.canvas, layer.tiles[i], frame);
+        }
+    });
+    stats.composed += layer.tiles.size();
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "RecordingIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+const uint32_t MAGIC = 0x58495246;  // "FRIX"
+const uint32_t VERSION = 1;
+const size_t RECORD_HEADER = 3;     // tip + uzunluk
+
+template <typename T>
+void appendRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Sınırları denetlenen sıralı okuyucu
+class Reader {
+public:
+    Reader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (offset + sizeof(T) > size) return false;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint8_t length;
+        if (!read(length) || offset + length > size) return false;
+        value.assign(data + offset, length);
+        offset += length;
+        return true;
+    }
+
+    size_t position() const { return offset; }
+
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+};
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) return false;
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+}
+
+RecordingIndex::RecordingIndex() : fd(-1) {
+}
+
+RecordingIndex::~RecordingIndex() {
+    close();
+}
+
+std::string RecordingIndex::sidecarPath(const std::string& videoPath) {
+    return fs::path(videoPath).replace_extension(".idx").string();
+}
+
+bool RecordingIndex::open(const std::string& path, const Header& header) {
+    close();
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd < 0) return false;
+    
+    buffer.clear();
+    appendRaw(buffer, MAGIC);
+    appendRaw(buffer, VERSION);
+    appendRaw(buffer, header.fourcc);
+    appendRaw(buffer, header.fps);
+    appendRaw(buffer, header.width);
+    appendRaw(buffer, header.height);
+    appendRaw(buffer, header.startTime);
+    return flush();
+}
+
+void RecordingIndex::beginRecord(RecordType type, size_t& lengthOffset) {
+    buffer.push_back(static_cast<char>(type));
+    lengthOffset = buffer.size();
+    appendRaw(buffer, static_cast<uint16_t>(0));
+}
+
+void RecordingIndex::endRecord(size_t lengthOffset) {
+    uint16_t length = static_cast<uint16_t>(buffer.size() - lengthOffset - sizeof(uint16_t));
+    std::memcpy(&buffer[lengthOffset], &length, sizeof(length));
+}
+
+void RecordingIndex::appendFrame(uint32_t frameIndex, double mediaTime, double wallTime,
+                                 bool keyframe) {
+    if (fd < 0) return;
+    size_t lengthOffset;
+    beginRecord(RECORD_FRAME, lengthOffset);
+    appendRaw(buffer, frameIndex);
+    appendRaw(buffer, mediaTime);
+    appendRaw(buffer, wallTime);
+    appendRaw(buffer, static_cast<uint8_t>(keyframe ? 1 : 0));
+    endRecord(lengthOffset);
+    
+    if (buffer.size() >= FLUSH_BYTES) flush();
+}
+
+void RecordingIndex::appendTracks(uint32_t frameIndex,
+                                  const TrackingSystem::TrackSnapshot& snapshot) {
+    if (fd < 0) return;
+    for (const auto& track : snapshot.tracks) {
+        size_t lengthOffset;
+        beginRecord(RECORD_TRACK, lengthOffset);
+        appendRaw(buffer, frameIndex);
+        appendRaw(buffer, static_cast<int32_t>(track.displayId));
+        appendRaw(buffer, static_cast<int32_t>(track.bbox.x));
+        appendRaw(buffer, static_cast<int32_t>(track.bbox.y));
+        appendRaw(buffer, static_cast<int32_t>(track.bbox.width));
+        appendRaw(buffer, static_cast<int32_t>(track.bbox.height));
+        appendRaw(buffer, track.speed);
+        
+        size_t nameLength = std::min<size_t>(track.className.size(), 255);
+        appendRaw(buffer, static_cast<uint8_t>(nameLength));
+        buffer.append(track.className, 0, nameLength);
+        
+        size_t zoneCount = std::min<size_t>(track.zones.size(), 255);
+        appendRaw(buffer, static_cast<uint8_t>(zoneCount));
+        for (size_t i = 0; i < zoneCount; i++) {
+            appendRaw(buffer, static_cast<int16_t>(track.zones[i]));
+        }
+        endRecord(lengthOffset);
+    }
+    
+    if (buffer.size() >= FLUSH_BYTES) flush();
+}
+
+bool RecordingIndex::flush() {
+    if (fd < 0 || buffer.empty()) return fd >= 0;
+    bool ok = writeAll(fd, buffer.data(), buffer.size());
+    buffer.clear();
+    return ok;
+}
+
+void RecordingIndex::close() {
+    if (fd < 0) return;
+    flush();
+    ::fdatasync(fd);
+    ::close(fd);
+    fd = -1;
+}
+
+void RecordingIndex::scanFile(const std::string& indexPath, const Query& query,
+                              std::vector<Hit>& hits) {
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in) return;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    
+    Reader header(data.data(), data.size());
+    uint32_t magic, version;
+    Header info;
+    if (!header.read(magic) || !header.read(version) || magic != MAGIC || version != VERSION ||
+        !header.read(info.fourcc) || !header.read(info.fps) || !header.read(info.width) ||
+        !header.read(info.height) || !header.read(info.startTime)) {
+        return;
+    }
+    
+    // Video aynı adın başka uzantılısı; dizinde ara
+    std::string videoPath;
+    fs::path stem = fs::path(indexPath).replace_extension();
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(fs::path(indexPath).parent_path(), error)) {
+        if (entry.path().stem() == stem.filename() && entry.path().extension() != ".idx") {
+            videoPath = entry.path().string();
+            break;
+        }
+    }
+    
+    size_t offset = header.position();
+    uint32_t currentFrame = 0, lastKeyframe = 0;
+    double mediaTime = 0.0, wallTime = info.startTime;
+    
+    while (offset + RECORD_HEADER <= data.size()) {
+        uint8_t type = static_cast<uint8_t>(data[offset]);
+        uint16_t length;
+        std::memcpy(&length, data.data() + offset + 1, sizeof(length));
+        if (offset + RECORD_HEADER + length > data.size()) break;  // Yarım kayıt
+        Reader record(data.data() + offset + RECORD_HEADER, length);
+        offset += RECORD_HEADER + length;
+        
+        if (type == RECORD_FRAME) {
+            uint8_t keyframe = 0;
+            if (!record.read(currentFrame) || !record.read(mediaTime) ||
+                !record.read(wallTime) || !record.read(keyframe)) break;
+            if (keyframe) lastKeyframe = currentFrame;
+            continue;
+        }
+        if (type != RECORD_TRACK || wallTime < query.from || wallTime > query.to) continue;
+        
+        Hit hit;
+        int32_t trackId, x, y, width, height;
+        uint8_t zoneCount;
+        if (!record.read(hit.frameIndex) || !record.read(trackId) || !record.read(x) ||
+            !record.read(y) || !record.read(width) || !record.read(height) ||
+            !record.read(hit.speed) || !record.readString(hit.className) ||
+            !record.read(zoneCount)) break;
+        for (uint8_t i = 0; i < zoneCount; i++) {
+            int16_t zone;
+            if (!record.read(zone)) break;
+            hit.zones.push_back(zone);
+        }
+        
+        if (!query.className.empty() && hit.className != query.className) continue;
+        if (query.zone >= 0 &&
+            std::find(hit.zones.begin(), hit.zones.end(), query.zone) == hit.zones.end()) continue;
+        
+        hit.videoPath = videoPath;
+        hit.keyframeIndex = lastKeyframe;
+        hit.mediaTime = mediaTime;
+        hit.wallTime = wallTime;
+        hit.trackId = trackId;
+        hit.bbox = cv::Rect(x, y, width, height);
+        hits.push_back(std::move(hit));
+    }
+}
+
+std::vector<RecordingIndex::Hit> RecordingIndex::scan(const std::string& directory,
+                                                      const Query& query) {
+    std::vector<std::string> indexFiles;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ".idx") indexFiles.push_back(entry.path().string());
+    }
+    // Dosya adları zaman damgası ve segment numarası taşır
+    std::sort(indexFiles.begin(), indexFiles.end());
+    
+    std::vector<Hit> hits;
+    for (const auto& path : indexFiles) {
+        scanFile(path, query, hits);
+    }
+    return hits;
+}
+
+bool RecordingIndex::seek(cv::VideoCapture& capture, const Hit& hit) {
+    if (hit.videoPath.empty() || !capture.open(hit.videoPath)) return false;
+    return capture.set(cv::CAP_PROP_POS_FRAMES, hit.frameIndex);
+}
\ No newline at end of file
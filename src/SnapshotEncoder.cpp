@@ -0,0 +1,144 @@
+#include "SnapshotEncoder.hpp"
+#include "VideoUtils.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+SnapshotEncoder::SnapshotEncoder(const std::string& directory, int workerCount,
+                                 size_t memoryBudget, int jpegQuality)
+    : directory(directory), memoryBudget(memoryBudget), jpegQuality(jpegQuality),
+      stopRequested(false), nextSequence(0) {
+    // Dizin oluşturulamazsa yazmalar başarısız sayılır; tespit akışı durmaz
+    std::error_code error;
+    fs::create_directories(directory, error);
+    
+    for (int i = 0; i < std::max(1, workerCount); i++) {
+        workers.emplace_back(&SnapshotEncoder::workerLoop, this);
+    }
+}
+
+SnapshotEncoder::~SnapshotEncoder() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopRequested = true;
+    }
+    jobCondition.notify_all();
+    
+    // İşçiler kuyruktakileri bitirip çıkar
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t SnapshotEncoder::retainedBytes(const cv::Mat& image) {
+    // ROI tüm kaynak tamponu canlı tutar; bütçe ayrılan tampon üzerinden sayılır
+    if (image.u) {
+        return image.u->size;
+    }
+    return image.total() * image.elemSize();
+}
+
+std::string SnapshotEncoder::submit(const cv::Mat& image, const std::string& prefix) {
+    if (image.empty()) return "";
+    
+    std::string name = prefix + "_" + VideoUtils::getTimeStamp() + "_" +
+                       std::to_string(nextSequence++) + ".jpg";
+    Job job{image, (fs::path(directory) / name).string(), retainedBytes(image)};
+    
+    std::string link;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (stopRequested) return "";
+        
+        if (stats.queuedBytes + job.bytes > memoryBudget) {
+            stats.dropped++;
+            return "";
+        }
+        
+        link = publicBaseUrl.empty() ? job.path : publicBaseUrl + name;
+        stats.submitted++;
+        stats.queuedBytes += job.bytes;
+        jobs.push_back(std::move(job));
+    }
+    jobCondition.notify_one();
+    return link;
+}
+
+cv::Mat SnapshotEncoder::contextCrop(const cv::Mat& frame, const cv::Rect& region) {
+    int marginX = region.width / 4;
+    int marginY = region.height / 4;
+    cv::Rect crop(region.x - marginX, region.y - marginY,
+                  region.width + 2 * marginX, region.height + 2 * marginY);
+    crop &= cv::Rect(0, 0, frame.cols, frame.rows);
+    if (crop.width <= 0 || crop.height <= 0) {
+        return cv::Mat();
+    }
+    return frame(crop);
+}
+
+void SnapshotEncoder::setPublicBaseUrl(const std::string& url) {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    publicBaseUrl = url;
+    if (!publicBaseUrl.empty() && publicBaseUrl.back() != '/') {
+        publicBaseUrl += '/';
+    }
+}
+
+SnapshotEncoder::Stats SnapshotEncoder::getStats() {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    return stats;
+}
+
+bool SnapshotEncoder::writeJpeg(const Job& job, std::vector<uchar>& buffer,
+                                const std::vector<int>& params) {
+    try {
+        if (!cv::imencode(".jpg", job.image, buffer, params)) {
+            return false;
+        }
+    } catch (const cv::Exception&) {
+        return false;
+    }
+    
+    // Geçici dosya + rename: bağlantıyı izleyen okuyucu yarım dosya görmez
+    std::string temp = job.path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size()));
+        if (!out) return false;
+    }
+    return std::rename(temp.c_str(), job.path.c_str()) == 0;
+}
+
+void SnapshotEncoder::workerLoop() {
+    std::vector<uchar> buffer;  // İşçi başına yeniden kullanılan kodlama tamponu
+    const std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, jpegQuality};
+    
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCondition.wait(lock, [this]() { return stopRequested || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        
+        bool ok = writeJpeg(job, buffer, params);
+        job.image.release();  // Tampon bütçeden düşülmeden önce bırakılır
+        
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stats.queuedBytes -= job.bytes;
+        if (ok) {
+            stats.written++;
+        } else {
+            stats.failed++;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "TrackAssociation.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+const int MIN_CELL_SIZE = 32;
+const int MAX_GRID_DIM = 128;
+
+int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+}
+
+TrackAssociation::SpatialGrid::SpatialGrid(const std::vector<cv::Rect>& boxes)
+    : cellSize(MIN_CELL_SIZE), gridCols(0), gridRows(0) {
+    if (boxes.empty()) return;
+
+    // Izgara sınırları ve hücre boyutu (ortalama kutu boyutunun iki katı)
+    bounds = boxes[0];
+    long long sizeSum = 0;
+    for (const auto& box : boxes) {
+        bounds |= box;
+        sizeSum += std::max(box.width, box.height);
+    }
+    cellSize = std::max(MIN_CELL_SIZE, static_cast<int>(2 * sizeSum / boxes.size()));
+    cellSize = std::max(cellSize, std::max(bounds.width, bounds.height) / MAX_GRID_DIM + 1);
+
+    gridCols = bounds.width / cellSize + 1;
+    gridRows = bounds.height / cellSize + 1;
+
+    // İki geçişli sayma sıralaması ile CSR yerleşimi
+    cellStart.assign(gridCols * gridRows + 1, 0);
+    for (const auto& box : boxes) {
+        cv::Rect range = cellRange(box);
+        for (int cy = range.y; cy < range.y + range.height; cy++) {
+            for (int cx = range.x; cx < range.x + range.width; cx++) {
+                cellStart[cy * gridCols + cx + 1]++;
+            }
+        }
+    }
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
+
+    cellItems.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < static_cast<int>(boxes.size()); i++) {
+        cv::Rect range = cellRange(boxes[i]);
+        for (int cy = range.y; cy < range.y + range.height; cy++) {
+            for (int cx = range.x; cx < range.x + range.width; cx++) {
+                cellItems[fill[cy * gridCols + cx]++] = i;
+            }
+        }
+    }
+}
+
+cv::Rect TrackAssociation::SpatialGrid::cellRange(const cv::Rect& box) const {
+    int x0 = std::clamp((box.x - bounds.x) / cellSize, 0, gridCols - 1);
+    int y0 = std::clamp((box.y - bounds.y) / cellSize, 0, gridRows - 1);
+    int x1 = std::clamp((box.x + box.width - bounds.x) / cellSize, 0, gridCols - 1);
+    int y1 = std::clamp((box.y + box.height - bounds.y) / cellSize, 0, gridRows - 1);
+    return cv::Rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+}
+
+template <typename Fn>
+void TrackAssociation::SpatialGrid::query(const cv::Rect& box, Fn&& fn) const {
+    if (gridCols == 0 || (box & bounds).empty()) return;
+
+    cv::Rect range = cellRange(box);
+    for (int cy = range.y; cy < range.y + range.height; cy++) {
+        for (int cx = range.x; cx < range.x + range.width; cx++) {
+            int cell = cy * gridCols + cx;
+            for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                fn(cellItems[k]);
+            }
+        }
+    }
+}
+
+void TrackAssociation::computeIOU(const cv::Rect& box,
+                                  const float* x1, const float* y1,
+                                  const float* x2, const float* y2,
+                                  int count, float* out) {
+    const float bx1 = static_cast<float>(box.x);
+    const float by1 = static_cast<float>(box.y);
+    const float bx2 = static_cast<float>(box.x + box.width);
+    const float by2 = static_cast<float>(box.y + box.height);
+    const float boxArea = (bx2 - bx1) * (by2 - by1);
+
+    // Dallanmasız gövde: derleyici SIMD'e çevirebilir
+    for (int i = 0; i < count; i++) {
+        float w = std::max(0.0f, std::min(bx2, x2[i]) - std::max(bx1, x1[i]));
+        float h = std::max(0.0f, std::min(by2, y2[i]) - std::max(by1, y1[i]));
+        float intersection = w * h;
+        float unionArea = boxArea + (x2[i] - x1[i]) * (y2[i] - y1[i]) - intersection;
+        out[i] = unionArea > 0.0f ? intersection / unionArea : 0.0f;
+    }
+}
+
+std::vector<TrackAssociation::Candidate> TrackAssociation::findCandidates(
+    const std::vector<cv::Rect>& trackBoxes,
+    const std::vector<cv::Rect>& detectionBoxes,
+    float minIOU) {
+
+    std::vector<Candidate> candidates;
+    if (trackBoxes.empty() || detectionBoxes.empty()) return candidates;
+
+    SpatialGrid grid(detectionBoxes);
+
+    // Aday tespitlerin koordinatları SoA tamponlarına toplanır
+    std::vector<int> lastVisit(detectionBoxes.size(), -1);
+    std::vector<int> ids;
+    std::vector<float> x1, y1, x2, y2, iou;
+
+    for (int t = 0; t < static_cast<int>(trackBoxes.size()); t++) {
+        ids.clear();
+        x1.clear(); y1.clear(); x2.clear(); y2.clear();
+
+        grid.query(trackBoxes[t], [&](int d) {
+            if (lastVisit[d] == t) return;  // Birden çok hücrede olan kutu
+            lastVisit[d] = t;
+            const cv::Rect& box = detectionBoxes[d];
+            ids.push_back(d);
+            x1.push_back(static_cast<float>(box.x));
+            y1.push_back(static_cast<float>(box.y));
+            x2.push_back(static_cast<float>(box.x + box.width));
+            y2.push_back(static_cast<float>(box.y + box.height));
+        });
+
+        iou.resize(ids.size());
+        computeIOU(trackBoxes[t], x1.data(), y1.data(), x2.data(), y2.data(),
+                   static_cast<int>(ids.size()), iou.data());
+
+        for (size_t k = 0; k < ids.size(); k++) {
+            if (iou[k] > minIOU) {
+                candidates.push_back({t, ids[k], iou[k]});
+            }
+        }
+    }
+
+    return candidates;
+}
+
+std::vector<int> TrackAssociation::solveAssignment(const std::vector<float>& cost,
+                                                   int rows, int cols) {
+    std::vector<int> assignment(rows, -1);
+    if (rows == 0 || cols == 0) return assignment;
+
+    // Algoritma satır <= sütun varsayar; gerekirse transpoze çöz
+    if (rows > cols) {
+        std::vector<float> transposed(cost.size());
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                transposed[c * rows + r] = cost[r * cols + c];
+            }
+        }
+        std::vector<int> columnAssignment = solveAssignment(transposed, cols, rows);
+        for (int c = 0; c < cols; c++) {
+            if (columnAssignment[c] >= 0) {
+                assignment[columnAssignment[c]] = c;
+            }
+        }
+        return assignment;
+    }
+
+    // Kuhn-Munkres, potansiyellerle O(n^2 m)
+    const double INF = std::numeric_limits<double>::infinity();
+    std::vector<double> u(rows + 1, 0.0), v(cols + 1, 0.0);
+    std::vector<int> p(cols + 1, 0), way(cols + 1, 0);
+
+    for (int i = 1; i <= rows; i++) {
+        p[0] = i;
+        int j0 = 0;
+        std::vector<double> minv(cols + 1, INF);
+        std::vector<char> used(cols + 1, false);
+
+        do {
+            used[j0] = true;
+            int i0 = p[j0];
+            int j1 = 0;
+            double delta = INF;
+            const float* costRow = &cost[(i0 - 1) * cols];
+
+            for (int j = 1; j <= cols; j++) {
+                if (used[j]) continue;
+                double current = costRow[j - 1] - u[i0] - v[j];
+                if (current < minv[j]) {
+                    minv[j] = current;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+
+            for (int j = 0; j <= cols; j++) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    for (int j = 1; j <= cols; j++) {
+        if (p[j] != 0) {
+            assignment[p[j] - 1] = j - 1;
+        }
+    }
+    return assignment;
+}
+
+std::vector<int> TrackAssociation::associate(const std::vector<cv::Rect>& trackBoxes,
+                                             const std::vector<cv::Rect>& detectionBoxes,
+                                             float minIOU) {
+    const int numTracks = static_cast<int>(trackBoxes.size());
+    const int numDetections = static_cast<int>(detectionBoxes.size());
+    std::vector<int> assignment(numTracks, -1);
+
+    std::vector<Candidate> candidates = findCandidates(trackBoxes, detectionBoxes, minIOU);
+    if (candidates.empty()) return assignment;
+
+    // Bağlı bileşenler: izler [0, numTracks), tespitler [numTracks, ...)
+    std::vector<int> parent(numTracks + numDetections);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (const auto& c : candidates) {
+        int a = findRoot(parent, c.track);
+        int b = findRoot(parent, numTracks + c.detection);
+        if (a != b) parent[a] = b;
+    }
+
+    std::vector<int> component(numTracks);
+    for (int t = 0; t < numTracks; t++) {
+        component[t] = findRoot(parent, t);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [&component](const Candidate& a, const Candidate& b) {
+            int ca = component[a.track];
+            int cb = component[b.track];
+            return ca != cb ? ca < cb : a.track < b.track;
+        });
+
+    std::vector<int> localTrack(numTracks, -1);
+    std::vector<int> localDetection(numDetections, -1);
+    std::vector<int> tracksInComponent, detectionsInComponent;
+    std::vector<float> cost;
+
+    size_t begin = 0;
+    while (begin < candidates.size()) {
+        int root = component[candidates[begin].track];
+        size_t end = begin;
+        while (end < candidates.size() && component[candidates[end].track] == root) {
+            end++;
+        }
+
+        // Tek adaylı bileşen: doğrudan ata
+        if (end - begin == 1) {
+            assignment[candidates[begin].track] = candidates[begin].detection;
+            begin = end;
+            continue;
+        }
+
+        tracksInComponent.clear();
+        detectionsInComponent.clear();
+        for (size_t k = begin; k < end; k++) {
+            const auto& c = candidates[k];
+            if (localTrack[c.track] < 0) {
+                localTrack[c.track] = static_cast<int>(tracksInComponent.size());
+                tracksInComponent.push_back(c.track);
+            }
+            if (localDetection[c.detection] < 0) {
+                localDetection[c.detection] = static_cast<int>(detectionsInComponent.size());
+                detectionsInComponent.push_back(c.detection);
+            }
+        }
+
+        // Maliyet = 1 - IoU; aday olmayan çiftler eşik dışı (1.0)
+        const int rows = static_cast<int>(tracksInComponent.size());
+        const int cols = static_cast<int>(detectionsInComponent.size());
+        cost.assign(static_cast<size_t>(rows) * cols, 1.0f);
+        for (size_t k = begin; k < end; k++) {
+            const auto& c = candidates[k];
+            cost[localTrack[c.track] * cols + localDetection[c.detection]] = 1.0f - c.iou;
+        }
+
+        std::vector<int> local = solveAssignment(cost, rows, cols);
+        for (int r = 0; r < rows; r++) {
+            int col = local[r];
+            if (col >= 0 && cost[r * cols + col] < 1.0f) {
+                assignment[tracksInComponent[r]] = detectionsInComponent[col];
+            }
+        }
+
+        for (int t : tracksInComponent) localTrack[t] = -1;
+        for (int d : detectionsInComponent) localDetection[d] = -1;
+        begin = end;
+    }
+
+    return assignment;
+}
\ No newline at end of file
@@ -1,57 +1,87 @@
 #include "TrackingSystem.hpp"
+#include "TrackAssociation.hpp"
 #include <opencv2/tracking.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <iterator>
 
 TrackingSystem::TrackingSystem() {
     nightVisionEnabled = false;
-    nextTrackId = 0;
+    publishedFrames = 0;
+    nextDisplayId = 0;
     deltaTime = 0.033f; // ~30 FPS
+    currentTime = MediaTime(0);
+    hasLastUpdate = false;
+    publishSnapshot();
 }
 
-void TrackingSystem::updateTracks(const std::vector<Detection>& detections, 
-                                [[maybe_unused]] const cv::Mat& frame) {
+void TrackingSystem::updateTracks(std::vector<Detection>& detections, 
+                                const cv::Mat& frame,
+                                MediaTime timestamp) {
+    // Olay görüntüleri için kareye referans (kopya yok); tur sonunda bırakılır
+    currentFrame = frame;
+    
     std::vector<bool> detectionMatched(detections.size(), false);
     std::vector<bool> trackMatched(tracks.size(), false);
+    std::vector<int> trackDetection(tracks.size(), -1);
+
+    // Kareler arası süre (medya zamanı)
+    MediaTime now = timestamp;
+    if (hasLastUpdate) {
+        float elapsed = static_cast<float>((now - currentTime).count());
+        deltaTime = std::clamp(elapsed, MIN_DELTA_TIME, MAX_DELTA_TIME);
+    }
+    currentTime = now;
+    hasLastUpdate = true;
+
+    // Hareket modeli ile tüm izleri ileri taşı
+    motionFilter.predict(deltaTime);
+
+    // Optimal eşleştirme (ızgara ön eleme + Hungarian), tahmin edilen kutular üzerinde
+    std::vector<cv::Rect> trackBoxes;
+    std::vector<cv::Rect> detectionBoxes;
+    trackBoxes.reserve(tracks.size());
+    detectionBoxes.reserve(detections.size());
+    for (size_t i = 0; i < tracks.size(); i++) {
+        trackBoxes.push_back(motionFilter.predictedBox(static_cast<int>(i)));
+    }
+    for (const auto& det : detections) detectionBoxes.push_back(det.bbox);
+    
+    std::vector<int> assignment = TrackAssociation::associate(
+        trackBoxes, detectionBoxes, IOU_THRESHOLD);
 
     // Mevcut izleri güncelle
     for (size_t i = 0; i < tracks.size(); i++) {
         auto& track = tracks[i];
-        
-        // En iyi eşleşmeyi bul
-        double bestIOU = 0.3; // IOU eşik değeri
-        int bestMatch = -1;
-        
-        for (size_t j = 0; j < detections.size(); j++) {
-            if (detectionMatched[j]) continue;
-            
-            double iou = calculateIOU(track.bbox, detections[j].bbox);
-            if (iou > bestIOU) {
-                bestIOU = iou;
-                bestMatch = j;
-            }
-        }
+        int bestMatch = assignment[i];
         
         if (bestMatch != -1) {
             // İzi güncelle
             const auto& det = detections[bestMatch];
+            motionFilter.correct(static_cast<int>(i), det.bbox);
             track.bbox = det.bbox;
             track.className = det.className;
-            track.lastSeen = std::chrono::steady_clock::now();
+            track.lastSeen = now;
+            track.missedFrames = 0;
             track.trajectory.push_back(det.center);
-            track.speed = det.velocity;
-            track.isInRestrictedZone = isInRestrictedZone(det.center);
             
             // Yüz tanıma güncelleme
             if (!det.faceImage.empty()) {
                 track.face = det.faceImage;
-                processFaceRecognition(track);
+                processFaceRecognition(track, det.recognizedPerson);
             }
             
             detectionMatched[bestMatch] = true;
             trackMatched[i] = true;
+            trackDetection[i] = bestMatch;
+        } else if (++track.missedFrames <= MAX_MISSED_FRAMES) {
+            // Kısa kayıp: kutu tahminle ilerler (ara sıra kaçan tespitte iz korunur)
+            track.bbox = trackBoxes[i];
+        } else {
+            // Nesne büyük olasılıkla çıktı: son kutuda bekler, silinene kadar
+            // yeniden eşleşebilir ama hareket etmez
+            motionFilter.hold(static_cast<int>(i));
         }
     }
 
@@ -59,81 +89,100 @@ void TrackingSystem::updateTracks(const std::vector<Detection>& detections,
     for (size_t i = 0; i < detections.size(); i++) {
         if (!detectionMatched[i]) {
             TrackedObject newTrack;
-            newTrack.id = nextTrackId++;
             newTrack.bbox = detections[i].bbox;
             newTrack.className = detections[i].className;
-            newTrack.lastSeen = std::chrono::steady_clock::now();
+            newTrack.lastSeen = now;
+            newTrack.lastMoved = now;
             newTrack.trajectory.push_back(detections[i].center);
-            tracks.push_back(newTrack);
+            motionFilter.add(newTrack.bbox);
+            trackDetection.push_back(static_cast<int>(i));
+            
+            // Yuva anahtarı iç ID olur (iz silinene kadar kararlı); görünen ID
+            // yuva yeniden kullanımından bağımsız olarak artar
+            SlotMap<TrackedObject>::Key key = tracks.insert(std::move(newTrack));
+            TrackedObject& inserted = *tracks.get(key);
+            inserted.id = key;
+            inserted.displayId = ++nextDisplayId;
             
             // Yeni nesne bildirimi
-            notificationSystem.sendNotification({
-                NotificationSystem::NotificationType::MOTION_DETECTED,
-                "New object detected: " + newTrack.className,
-                getCurrentTimestamp(),
-                1,
-                ""  // imageUrl
-            });
+            publishEvent(EventBus::TrackCreated{inserted.bbox}, 1, &inserted);
         }
     }
 
+    // Hızları güncelle
+    updateTrackVelocities();
+    
+    // İz bilgisini tespitlere geri yaz (iz ID, hız, yön)
+    for (size_t i = 0; i < tracks.size(); i++) {
+        if (trackDetection[i] < 0) continue;
+        const auto& track = tracks[i];
+        auto& det = detections[trackDetection[i]];
+        det.trackId = track.displayId;
+        det.velocity = track.speed;
+        det.isMoving = track.isMoving;
+        det.direction = track.isMoving ?
+            cv::Point2f(std::cos(track.direction), std::sin(track.direction)) :
+            cv::Point2f(0, 0);
+    }
+
     // Eski izleri temizle
     removeStaleTracts();
     
+    // Bölge giriş/çıkışları (tüm izler tek toplu sorguda)
+    updateZoneMembership();
+    
+    // Hareketli izlerin öngörülen yollarını bölgelere karşı toplu test et
+    checkPredictedIntrusions();
+    
     // Güvenlik kontrollerini yap
     checkSecurityViolations();
     
-    // Hızları güncelle
-    updateTrackVelocities();
+    // Okuyucular için bu karenin görüntüsünü yayımla
+    publishSnapshot();
+    currentFrame.release();
 }
 
 void TrackingSystem::removeStaleTracts() {
-    auto now = std::chrono::steady_clock::now();
-    const int maxAge = MAX_TRACK_AGE * 1000; // capture this value
-    
-    auto it = std::remove_if(tracks.begin(), tracks.end(),
-        [now, maxAge](const TrackedObject& track) {
-            auto age = std::chrono::duration_cast<std::chrono::milliseconds>
-                      (now - track.lastSeen).count();
-            return age > maxAge;
-        });
-    tracks.erase(it, tracks.end());
+    const double maxAge = MAX_TRACK_AGE;  // saniye (medya zamanı)
+    
+    // Filtre durumu iz dizisiyle aynı sırada tutulur: ikisinden de takas ederek sil
+    for (size_t i = tracks.size(); i-- > 0;) {
+        double age = (currentTime - tracks[i].lastSeen).count();
+        if (age > maxAge) {
+            publishEvent(EventBus::TrackLost{}, 1, &tracks[i]);
+            tracks.eraseAt(i);
+            motionFilter.swapRemove(static_cast<int>(i));
+        }
+    }
 }
 
-void TrackingSystem::processFaceRecognition(TrackedObject& track) {
-    if (track.face.empty() || !faceRecognizer) return;
+void TrackingSystem::processFaceRecognition(TrackedObject& track,
+                                            const std::string& knownName) {
+    if (track.face.empty()) return;
     
-    try {
-        int label;
-        double confidence;
-        faceRecognizer->predict(track.face, label, confidence);
-        
-        if (confidence < 100.0) {  // Confidence threshold
-            track.recognizedPerson = knownFaces[label];
-            
-            notificationSystem.sendNotification({
-                NotificationSystem::NotificationType::FACE_RECOGNIZED,
-                "Recognized person: " + track.recognizedPerson,
-                getCurrentTimestamp(),
-                2,
-                ""  // imageUrl
-            });
+    // Detector zaten tanıdıysa galeriyi tekrar tarama
+    std::string person = knownName;
+    if (person.empty()) {
+        if (!faceGallery) return;
+        try {
+            person = faceGallery->identify(track.face).name;
+        } catch (const cv::Exception& e) {
+            return;
         }
-    } catch (const cv::Exception& e) {
-        // Log error
     }
+    
+    // Aynı kişi için her karede bildirim gönderme
+    if (person.empty() || person == track.recognizedPerson) return;
+    track.recognizedPerson = person;
+    
+    publishEvent(EventBus::FaceRecognized{person}, 2, &track, true);
 }
 
 void TrackingSystem::enableNightVision(bool enable) {
     if (nightVisionEnabled != enable) {
         nightVisionEnabled = enable;
-        notificationSystem.sendNotification({
-            NotificationSystem::NotificationType::SYSTEM_STATUS,
-            nightVisionEnabled ? "Night vision enabled" : "Night vision disabled",
-            getCurrentTimestamp(),
-            1,
-            ""  // imageUrl
-        });
+        publishEvent(EventBus::SystemStatus{
+            nightVisionEnabled ? "Night vision enabled" : "Night vision disabled"}, 1);
     }
 }
 
@@ -159,12 +208,34 @@ cv::Mat TrackingSystem::enhanceNightVision(const cv::Mat& frame) {
     return enhanced;
 }
 
-std::vector<TrackingSystem::TrackedObject> TrackingSystem::getTracks() const {
-    return tracks;
+TrackingSystem::TrackSnapshotPtr TrackingSystem::getTracks() const {
+    return std::atomic_load(&publishedSnapshot);
 }
 
-void TrackingSystem::drawTrajectories(cv::Mat& frame) {
-    for (const auto& track : tracks) {
+void TrackingSystem::publishSnapshot() {
+    // Çift tampon: önceki görüntüyü tutan okuyucu kalmadıysa belleğini yeniden
+    // kullan (string/yörünge kapasiteleri korunur), aksi halde yenisini ayır.
+    // Yayından kalkmış görüntüye yeni referans alınamaz; sayaç 1 ise yalnız bizdeyiz.
+    std::shared_ptr<TrackSnapshot> next;
+    if (spareSnapshot && spareSnapshot.use_count() == 1) {
+        // Okuyucunun son erişimleri bizim yazmalarımızdan önce tamamlanmış olsun
+        std::atomic_thread_fence(std::memory_order_acquire);
+        next = std::move(spareSnapshot);
+    } else {
+        next = std::make_shared<TrackSnapshot>();
+    }
+    
+    next->timestamp = currentTime;
+    next->frameNumber = ++publishedFrames;
+    next->tracks.assign(tracks.begin(), tracks.end());
+    
+    TrackSnapshotPtr previous = std::atomic_exchange(&publishedSnapshot, TrackSnapshotPtr(next));
+    spareSnapshot = std::const_pointer_cast<TrackSnapshot>(previous);
+}
+
+void TrackingSystem::drawTrajectories(cv::Mat& frame) const {
+    TrackSnapshotPtr snapshot = getTracks();
+    for (const auto& track : snapshot->tracks) {
         if (track.trajectory.size() < 2) continue;
         
         cv::Scalar color = track.isInRestrictedZone ? 
@@ -193,147 +264,210 @@ void TrackingSystem::drawTrajectories(cv::Mat& frame) {
     }
 }
 
-bool TrackingSystem::isInRestrictedZone(const cv::Point& point) {
-    // Yasak bölgeleri kontrol et
-    for (const auto& zone : restrictedZones) {
-        if (zone.contains(point)) {
-            return true;
+void TrackingSystem::updateZoneMembership() {
+    if (restrictedZones.empty()) return;
+    
+    std::vector<cv::Point2f> centers;
+    centers.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        centers.emplace_back(track.bbox.x + track.bbox.width * 0.5f,
+                             track.bbox.y + track.bbox.height * 0.5f);
+    }
+    
+    std::vector<ZoneIndex::Hit> hits;
+    restrictedZones.containsBatch(centers, hits);
+    
+    // Sonuçlar iz sırasında: yalnızca üyeliği değişen izler için olay üret
+    std::vector<int> current, entered, left;
+    size_t h = 0;
+    for (size_t i = 0; i < tracks.size(); i++) {
+        auto& track = tracks[i];
+        current.clear();
+        while (h < hits.size() && hits[h].point == static_cast<int>(i)) {
+            current.push_back(hits[h++].zone);
         }
+        // Bu karede görülmeyen izin üyeliği son gözlemdeki gibi kalır
+        if (track.missedFrames > 0 || current == track.zones) continue;
+        
+        entered.clear();
+        left.clear();
+        std::set_difference(current.begin(), current.end(),
+                            track.zones.begin(), track.zones.end(),
+                            std::back_inserter(entered));
+        std::set_difference(track.zones.begin(), track.zones.end(),
+                            current.begin(), current.end(),
+                            std::back_inserter(left));
+        
+        for (int z : entered) {
+            publishEvent(EventBus::ZoneEntered{z, restrictedZones.zone(z).name},
+                         3, &track, true);
+        }
+        for (int z : left) {
+            publishEvent(EventBus::ZoneExited{z, restrictedZones.zone(z).name}, 1, &track);
+        }
+        
+        track.zones.swap(current);
+        track.isInRestrictedZone = !track.zones.empty();
     }
-    return false;
 }
 
-void TrackingSystem::checkSecurityViolations() {
-    auto now = std::chrono::steady_clock::now();
+void TrackingSystem::checkPredictedIntrusions() {
+    if (restrictedZones.empty() || PREDICTION_HORIZON <= 0) return;
     
-    for (auto& track : tracks) {
-        // Yasak bölge ihlali
-        if (track.isInRestrictedZone && !track.violationReported) {
-            notificationSystem.sendNotification({
-                NotificationSystem::NotificationType::ZONE_VIOLATION,
-                "Object ID " + std::to_string(track.id) + 
-                " (" + track.className + ") entered restricted zone",
-                getCurrentTimestamp(),
-                3,
-                ""  // imageUrl
-            });
-            track.violationReported = true;
+    // Hareket modeliyle her hareketli izin horizon sonrasına uzanan parçası
+    std::vector<int> moving;
+    for (size_t i = 0; i < tracks.size(); i++) {
+        if (tracks[i].isMoving) {
+            moving.push_back(static_cast<int>(i));
+        } else {
+            tracks[i].approachingZones.clear();
+        }
+    }
+    
+    std::vector<cv::Point2f> from, to;
+    motionFilter.project(moving, static_cast<float>(PREDICTION_HORIZON), from, to);
+    
+    std::vector<ZoneIndex::SegmentHit> hits;
+    restrictedZones.intersectsBatch(from, to, hits);
+    
+    // Sonuçlar parça sırasında; uyarı her yaklaşma için bir kez verilir
+    std::vector<int> predicted;
+    size_t h = 0;
+    for (size_t k = 0; k < moving.size(); k++) {
+        auto& track = tracks[moving[k]];
+        predicted.clear();
+        
+        for (; h < hits.size() && hits[h].segment == static_cast<int>(k); h++) {
+            int z = hits[h].zone;
+            // Zaten içinde olduğu bölgenin sınırı çıkıştır, uyarı değil
+            if (std::binary_search(track.zones.begin(), track.zones.end(), z)) continue;
+            predicted.push_back(z);
+            
+            if (std::binary_search(track.approachingZones.begin(),
+                                   track.approachingZones.end(), z)) {
+                continue;
+            }
+            
+            double eta = hits[h].t * PREDICTION_HORIZON;
+            publishEvent(EventBus::ZoneApproaching{z, restrictedZones.zone(z).name, eta},
+                         2, &track, true);
         }
         
-        // Hız ihlali kontrolü
-        if (track.speed > MAX_ALLOWED_VELOCITY) {
-            notificationSystem.sendNotification({
-                NotificationSystem::NotificationType::SECURITY_ALERT,
-                "High speed movement detected: " + 
-                std::to_string(static_cast<int>(track.speed)) + " m/s",
-                getCurrentTimestamp(),
-                2,
-                ""  // imageUrl
-            });
+        track.approachingZones.swap(predicted);
+    }
+}
+
+void TrackingSystem::checkSecurityViolations() {
+    MediaTime now = currentTime;
+    
+    for (auto& track : tracks) {
+        // Hız ihlali kontrolü (yalnızca bu karede ölçülen izler)
+        if (track.missedFrames == 0 && track.speed > MAX_ALLOWED_VELOCITY) {
+            publishEvent(EventBus::SpeedViolation{track.speed}, 2, &track, true);
         }
         
         // Gece aktivitesi kontrolü
         if (nightVisionEnabled && 
             !track.nightActivityReported && 
             track.isMoving) {
-            notificationSystem.sendNotification({
-                NotificationSystem::NotificationType::NIGHT_ACTIVITY,
-                "Night activity detected: " + track.className,
-                getCurrentTimestamp(),
-                2,
-                ""  // imageUrl
-            });
+            publishEvent(EventBus::NightActivity{}, 2, &track, true);
             track.nightActivityReported = true;
         }
         
         // Uzun süreli durağan nesne kontrolü
         if (track.trajectory.size() > 1) {
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>
-                          (now - track.lastMoved).count();
+            double duration = (now - track.lastMoved).count();
             if (duration > MAX_STATIONARY_TIME && !track.stationaryReported) {
-                notificationSystem.sendNotification({
-                    NotificationSystem::NotificationType::SECURITY_ALERT,
-                    "Suspicious stationary object: " + track.className,
-                    getCurrentTimestamp(),
-                    2,
-                    ""  // imageUrl
-                });
+                publishEvent(EventBus::StationaryObject{}, 2, &track, true);
                 track.stationaryReported = true;
             }
         }
     }
 }
 
-double TrackingSystem::calculateIOU(const cv::Rect& box1, const cv::Rect& box2) {
-    int x1 = std::max(box1.x, box2.x);
-    int y1 = std::max(box1.y, box2.y);
-    int x2 = std::min(box1.x + box1.width, box2.x + box2.width);
-    int y2 = std::min(box1.y + box1.height, box2.y + box2.height);
-    
-    if (x2 <= x1 || y2 <= y1) return 0.0;
-    
-    int intersection = (x2 - x1) * (y2 - y1);
-    int union_area = box1.width * box1.height + 
-                    box2.width * box2.height - intersection;
-                    
-    return static_cast<double>(intersection) / union_area;
+void TrackingSystem::addRestrictedZone(const cv::Rect& zone) {
+    addRestrictedZone({zone.tl(), cv::Point(zone.x + zone.width, zone.y),
+                       zone.br(), cv::Point(zone.x, zone.y + zone.height)});
 }
 
-void TrackingSystem::addRestrictedZone(const cv::Rect& zone) {
-    restrictedZones.push_back(zone);
-    notificationSystem.sendNotification({
-        NotificationSystem::NotificationType::SYSTEM_STATUS,
-        "New restricted zone added",
-        getCurrentTimestamp(),
-        1,
-        ""  // imageUrl
-    });
+void TrackingSystem::addRestrictedZone(const std::vector<cv::Point>& polygon,
+                                       const std::string& name) {
+    if (restrictedZones.addZone(polygon, name) < 0) return;
+    publishEvent(EventBus::SystemStatus{"New restricted zone added"}, 1);
 }
 
 void TrackingSystem::clearRestrictedZones() {
     restrictedZones.clear();
-    notificationSystem.sendNotification({
-        NotificationSystem::NotificationType::SYSTEM_STATUS,
-        "All restricted zones cleared",
-        getCurrentTimestamp(),
-        1,
-        ""  // imageUrl
-    });
+    for (auto& track : tracks) {
+        track.zones.clear();
+        track.approachingZones.clear();
+        track.isInRestrictedZone = false;
+    }
+    publishEvent(EventBus::SystemStatus{"All restricted zones cleared"}, 1);
 }
 
-std::string TrackingSystem::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+void TrackingSystem::publishEvent(EventBus::Payload payload, int priority,
+                                  const TrackedObject* track, bool attachSnapshot) {
+    if (!eventBus) return;
+    
+    EventBus::Event event;
+    event.payload = std::move(payload);
+    event.priority = priority;
+    event.timestamp = currentTime;
+    if (track) {
+        event.trackId = track->displayId;
+        event.className = track->className;
+        // İzin çevresi; karenin yalnızca referansı tutulur
+        if (attachSnapshot && !currentFrame.empty()) {
+            event.snapshot = SnapshotEncoder::contextCrop(currentFrame, track->bbox);
+        }
+    }
+    eventBus->publish(std::move(event));
 }
 
 void TrackingSystem::updateTrackVelocities() {
-    for (auto& track : tracks) {
-        if (track.trajectory.size() < 2) continue;
+    MediaTime now = currentTime;
+    
+    for (size_t i = 0; i < tracks.size(); i++) {
+        auto& track = tracks[i];
         
-        const auto& current = track.trajectory.back();
-        const auto& prev = track.trajectory[track.trajectory.size() - 2];
+        // Bu karede görülmeyen iz hareketli sayılmaz (hayalet kutu)
+        if (track.missedFrames > 0) {
+            track.speed = 0.0f;
+            track.isMoving = false;
+            continue;
+        }
         
-        // Piksel cinsinden hız
-        double dx = current.x - prev.x;
-        double dy = current.y - prev.y;
-        double pixelVelocity = std::sqrt(dx*dx + dy*dy);
+        // Filtrelenmiş hız (piksel/saniye)
+        cv::Point2f velocity = motionFilter.velocity(static_cast<int>(i));
+        double pixelVelocity = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
         
         // Gerçek dünya hızına dönüştür (m/s)
-        track.speed = pixelVelocity * PIXEL_TO_METER_RATIO / deltaTime;
+        track.speed = pixelVelocity * PIXEL_TO_METER_RATIO;
         
-        if (pixelVelocity > MIN_MOVEMENT_THRESHOLD) {
+        // Eşik kare başına piksel cinsinden
+        if (pixelVelocity * deltaTime > MIN_MOVEMENT_THRESHOLD) {
             track.isMoving = true;
-            track.lastMoved = std::chrono::steady_clock::now();
-            track.direction = std::atan2(dy, dx);
+            track.lastMoved = now;
+            track.direction = std::atan2(velocity.y, velocity.x);
         } else {
             track.isMoving = false;
         }
     }
 }
 
+void TrackingSystem::setFaceGallery(std::shared_ptr<FaceGallery> gallery) {
+    faceGallery = std::move(gallery);
+}
+
+void TrackingSystem::setEventBus(std::shared_ptr<EventBus> bus) {
+    eventBus = std::move(bus);
+}
+
+void TrackingSystem::setPredictionHorizon(double seconds) {
+    PREDICTION_HORIZON = std::max(0.0, seconds);
+}
+
 void TrackingSystem::setMotionThresholds(double maxVelocity, 
                                        double minMovement) {
     MAX_ALLOWED_VELOCITY = maxVelocity;
@@ -343,17 +477,15 @@ void TrackingSystem::setMotionThresholds(double maxVelocity,
 std::vector<cv::Point> TrackingSystem::predictTrajectory(
     const TrackedObject& track, int frames) {
     
-    if (track.trajectory.size() < 2) return {};
+    int index = tracks.find(track.id);
+    if (index < 0) return {};
     
+    // Kalman durumu kayan noktada ileri sarılır; yavaş nesneler sıfıra yuvarlanmaz
     std::vector<cv::Point> prediction;
-    float speed = track.speed;
-    float direction = track.direction;
-    
-    cv::Point lastPos = track.trajectory.back();
-    for (int i = 0; i < frames; i++) {
-        lastPos.x += static_cast<int>(speed * std::cos(direction) * deltaTime);
-        lastPos.y += static_cast<int>(speed * std::sin(direction) * deltaTime);
-        prediction.push_back(lastPos);
+    prediction.reserve(frames);
+    for (const auto& p : motionFilter.extrapolate(index, deltaTime, frames)) {
+        prediction.emplace_back(static_cast<int>(std::lround(p.x)),
+                                static_cast<int>(std::lround(p.y)));
     }
     
     return prediction;
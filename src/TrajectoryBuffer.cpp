@@ -0,0 +1,153 @@
+#include "TrajectoryBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const float ONLINE_TOLERANCE = 2.0f;   // Çevrimiçi mesafe/doğrusallık eşiği (piksel)
+const float INITIAL_TOLERANCE = 2.0f;  // Douglas-Peucker başlangıç toleransı
+
+// p noktasının a-b doğru parçasına uzaklığı
+float segmentDistance(const cv::Point& p, const cv::Point& a, const cv::Point& b) {
+    float dx = static_cast<float>(b.x - a.x);
+    float dy = static_cast<float>(b.y - a.y);
+    float px = static_cast<float>(p.x - a.x);
+    float py = static_cast<float>(p.y - a.y);
+    float lengthSq = dx * dx + dy * dy;
+    if (lengthSq <= 0.0f) {
+        return std::sqrt(px * px + py * py);
+    }
+    float t = std::max(0.0f, std::min(1.0f, (px * dx + py * dy) / lengthSq));
+    float ex = px - t * dx;
+    float ey = py - t * dy;
+    return std::sqrt(ex * ex + ey * ey);
+}
+}
+
+TrajectoryBuffer::TrajectoryBuffer()
+    : recentHead(0), recentCount(0),
+      absorbedCount(0), pushedCount(0) {
+}
+
+void TrajectoryBuffer::push(const cv::Point& point) {
+    if (recentCount == RECENT_CAPACITY) {
+        // En eski nokta uzun dönem çizgiye geçer
+        appendHistory(recent[recentHead]);
+        recent[recentHead] = point;
+        recentHead = (recentHead + 1) % RECENT_CAPACITY;
+    } else {
+        recent[(recentHead + recentCount) % RECENT_CAPACITY] = point;
+        recentCount++;
+    }
+    pushedCount++;
+}
+
+void TrajectoryBuffer::clear() {
+    recentHead = 0;
+    recentCount = 0;
+    history.clear();
+    absorbedCount = 0;
+    pushedCount = 0;
+}
+
+const cv::Point& TrajectoryBuffer::operator[](size_t index) const {
+    if (index < history.size()) {
+        return history[index];
+    }
+    return recent[(recentHead + index - history.size()) % RECENT_CAPACITY];
+}
+
+const cv::Point& TrajectoryBuffer::back() const {
+    return (*this)[size() - 1];
+}
+
+std::vector<cv::Point> TrajectoryBuffer::points() const {
+    std::vector<cv::Point> result;
+    result.reserve(size());
+    result.insert(result.end(), history.begin(), history.end());
+    for (size_t i = 0; i < recentCount; i++) {
+        result.push_back(recent[(recentHead + i) % RECENT_CAPACITY]);
+    }
+    return result;
+}
+
+void TrajectoryBuffer::appendHistory(const cv::Point& point) {
+    if (!history.empty()) {
+        const cv::Point& last = history.back();
+        float dx = static_cast<float>(point.x - last.x);
+        float dy = static_cast<float>(point.y - last.y);
+
+        // Mesafe eşiği: son noktaya çok yakın noktaları atla
+        if (dx * dx + dy * dy < ONLINE_TOLERANCE * ONLINE_TOLERANCE) {
+            return;
+        }
+
+        // Doğrusallık: son nokta ve segmente daha önce katılanlar yeni segment
+        // üzerindeyse segmenti uzat
+        if (history.size() >= 2 && absorbedCount < MAX_ABSORBED) {
+            const cv::Point& anchor = history[history.size() - 2];
+            bool collinear = segmentDistance(last, anchor, point) < ONLINE_TOLERANCE;
+            for (size_t i = 0; collinear && i < absorbedCount; i++) {
+                collinear = segmentDistance(absorbed[i], anchor, point) < ONLINE_TOLERANCE;
+            }
+            if (collinear) {
+                absorbed[absorbedCount++] = last;
+                history.back() = point;
+                return;
+            }
+        }
+    }
+
+    if (history.empty()) {
+        history.reserve(HISTORY_CAPACITY);
+    }
+    history.push_back(point);
+    absorbedCount = 0;
+
+    if (history.size() >= HISTORY_CAPACITY) {
+        simplifyHistory();
+    }
+}
+
+void TrajectoryBuffer::simplifyHistory() {
+    // Kapasitenin 3/4'üne inene kadar toleransı ikiye katlayarak Douglas-Peucker.
+    // Tolerans her seferinde baştan başlar; önceki taşmalardan birikmez.
+    std::vector<char> keep;
+    std::vector<std::pair<size_t, size_t>> stack;
+    float tolerance = INITIAL_TOLERANCE / 2.0f;
+
+    while (history.size() > HISTORY_CAPACITY * 3 / 4) {
+        tolerance *= 2.0f;
+
+        keep.assign(history.size(), 0);
+        keep.front() = keep.back() = 1;
+        stack.clear();
+        stack.emplace_back(0, history.size() - 1);
+
+        while (!stack.empty()) {
+            auto [first, last] = stack.back();
+            stack.pop_back();
+
+            float maxDistance = 0.0f;
+            size_t farthest = first;
+            for (size_t i = first + 1; i < last; i++) {
+                float d = segmentDistance(history[i], history[first], history[last]);
+                if (d > maxDistance) {
+                    maxDistance = d;
+                    farthest = i;
+                }
+            }
+
+            if (maxDistance > tolerance) {
+                keep[farthest] = 1;
+                stack.emplace_back(first, farthest);
+                stack.emplace_back(farthest, last);
+            }
+        }
+
+        size_t out = 0;
+        for (size_t i = 0; i < history.size(); i++) {
+            if (keep[i]) history[out++] = history[i];
+        }
+        history.resize(out);
+    }
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "VideoUtils.hpp"
+#include "AlertRing.hpp"
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
@@ -34,23 +36,40 @@ cv::VideoCapture VideoUtils::openVideo(const std::string& source) {
 }
 
 cv::VideoWriter VideoUtils::createVideoWriter(const RecordingConfig& config) {
+    return cv::VideoWriter(config.filename, codecFourcc(config.codec), config.fps, 
+                          recordingSize(config), config.isColor);
+}
+
+cv::Size VideoUtils::recordingSize(const RecordingConfig& config) {
     // Çözünürlük kontrolü
     int width = config.width;
     int height = config.height;
     checkResolution(width, height);
+    return cv::Size(width, height);
+}
+
+int VideoUtils::codecFourcc(Codec codec) {
+    switch (codec) {
+        case Codec::MJPG:
+            return cv::VideoWriter::fourcc('M','J','P','G');
+        case Codec::XVID:
+            return cv::VideoWriter::fourcc('X','V','I','D');
+        case Codec::H264:
+            return cv::VideoWriter::fourcc('a','v','c','1');
+        case Codec::PLATFORM_DEFAULT:
+            break;
+    }
     
     // Codec seçimi (platform bağımsız)
-    int fourcc;
-    #ifdef _WIN32
-        fourcc = cv::VideoWriter::fourcc('X','V','I','D');
-    #elif __APPLE__
-        fourcc = cv::VideoWriter::fourcc('M','J','P','G');
+    #ifdef __APPLE__
+        return cv::VideoWriter::fourcc('M','J','P','G');
     #else
-        fourcc = cv::VideoWriter::fourcc('X','V','I','D');
+        return cv::VideoWriter::fourcc('X','V','I','D');
     #endif
-    
-    return cv::VideoWriter(config.filename, fourcc, config.fps, 
-                          cv::Size(width, height), config.isColor);
+}
+
+std::string VideoUtils::codecExtension(Codec codec) {
+    return codec == Codec::H264 ? ".mp4" : ".avi";
 }
 
 VideoUtils::VideoInfo VideoUtils::getVideoInfo(const cv::VideoCapture& cap) {
@@ -200,21 +219,18 @@ void VideoUtils::drawFPS(cv::Mat& frame, float fps) {
 }
 
 void VideoUtils::drawDate(cv::Mat& frame) {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-    drawInfo(frame, ss.str(), cv::Point(frame.cols - 200, 30));
+    // İş parçacığı güvenli ve saniye başına önbellekli biçimleme
+    drawInfo(frame, AlertRing::formatTimestamp(std::chrono::system_clock::now()),
+             cv::Point(frame.cols - 200, 30));
 }
 
 void VideoUtils::drawGrid(cv::Mat& frame, int cellSize) {
+    const cv::Scalar color(50, 50, 50);
     for (int x = cellSize; x < frame.cols; x += cellSize) {
-        cv::line(frame, cv::Point(x, 0), cv::Point(x, frame.rows),
-                 cv::Scalar(50, 50, 50), 1);
+        cv::line(frame, cv::Point(x, 0), cv::Point(x, frame.rows), color, 1);
     }
     for (int y = cellSize; y < frame.rows; y += cellSize) {
-        cv::line(frame, cv::Point(0, y), cv::Point(frame.cols, y),
-                 cv::Scalar(50, 50, 50), 1);
+        cv::line(frame, cv::Point(0, y), cv::Point(frame.cols, y), color, 1);
     }
 }
 
@@ -279,6 +295,12 @@ void VideoUtils::saveFrame(const cv::Mat& frame, const std::string& filename) {
     }
 }
 
+void VideoUtils::detachIfShared(cv::Mat& frame) {
+    if (frame.u && frame.u->refcount > 1) {
+        frame.release();
+    }
+}
+
 bool VideoUtils::isVideoFile(const std::string& source) {
     std::string extensions[] = {".mp4", ".avi", ".mkv", ".mov", ".wmv"};
     std::string lowerSource = source;
@@ -294,11 +316,14 @@ bool VideoUtils::isVideoFile(const std::string& source) {
 }
 
 std::string VideoUtils::getTimeStamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y%m%d_%H%M%S");
-    return ss.str();
+    // Birden çok iş parçacığından çağrılır (anlık görüntü, klip, dosya adı):
+    // std::localtime'ın paylaşılan tamponu yerine localtime_r
+    std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm local;
+    localtime_r(&time, &local);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", &local);
+    return buffer;
 }
 
 void VideoUtils::checkResolution(int& width, int& height) {
@@ -1,16 +1,21 @@
 // WaterLevelDetector.cpp
 
 #include "WaterLevelDetector.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
 
 WaterLevelDetector::WaterLevelDetector() 
     : warningThreshold(70.0f), criticalThreshold(90.0f),
-      waveAmplitude(5.0f), waveFrequency(0.2f) {
+      waveAmplitude(5.0f), waveFrequency(0.2f),
+      sampleInterval(1.0), levelSmoothing(10.0), rateSmoothing(60.0),
+      samples{}, sampleCount(0), sampleIndex(0), alarmState(0),
+      trendWindow(600.0), wallOrigin(0.0), hasWallOrigin(false) {
     // Varsayılan referans noktaları
     topReference = cv::Point(0, 0);
     bottomReference = cv::Point(0, 100);
+    estimator.addGauge({"reference", cv::Point2f(topReference), cv::Point2f(bottomReference)});
     lastUpdateTime = std::chrono::steady_clock::now();
     
     // Dalga efekti için başlangıç offset'leri
@@ -20,11 +25,135 @@ WaterLevelDetector::WaterLevelDetector()
 void WaterLevelDetector::setReferencePoints(const cv::Point& top, const cv::Point& bottom) {
     topReference = top;
     bottomReference = bottom;
+    estimator.setGauge(0, {"reference", cv::Point2f(top), cv::Point2f(bottom)});
+}
+
+int WaterLevelDetector::addGauge(const std::string& name, const cv::Point& top,
+                                 const cv::Point& bottom, float bandWidth) {
+    return estimator.addGauge({name, cv::Point2f(top), cv::Point2f(bottom), bandWidth});
 }
 
 void WaterLevelDetector::setThresholds(float warning, float critical) {
     warningThreshold = warning;
     criticalThreshold = critical;
+    latest.warningLevel = warning;
+    latest.criticalLevel = critical;
+}
+
+void WaterLevelDetector::setSampleInterval(double seconds) {
+    sampleInterval = std::max(0.0, seconds);
+}
+
+void WaterLevelDetector::setSmoothing(double levelSeconds, double rateSeconds) {
+    levelSmoothing = std::max(0.0, levelSeconds);
+    rateSmoothing = std::max(0.0, rateSeconds);
+}
+
+void WaterLevelDetector::setEventBus(std::shared_ptr<EventBus> bus) {
+    eventBus = std::move(bus);
+}
+
+bool WaterLevelDetector::enableHistory(const std::string& path) {
+    return history.open(path);
+}
+
+void WaterLevelDetector::setTrendWindow(double seconds) {
+    trendWindow = std::max(10.0, seconds);
+}
+
+cv::Point WaterLevelDetector::measurePointFor(float level) const {
+    return cv::Point(
+        bottomReference.x,
+        bottomReference.y - (bottomReference.y - topReference.y) * (level / 100.0f)
+    );
+}
+
+const WaterLevelDetector::WaterLevelInfo& WaterLevelDetector::update(const cv::Mat& frame,
+                                                                     MediaTime timestamp) {
+    double elapsed = (timestamp - latest.timestamp).count();
+    if (latest.valid && elapsed < 0.0) {
+        // Medya zamanı geri gitti (FrameClock::reset, dedektör yeniden başlatıldı):
+        // aralık yeniden kurulur, ölçüm hemen yapılır; duvar saati bağı yenilenir
+        elapsed = sampleInterval;
+        hasWallOrigin = false;
+    }
+    if (latest.valid && elapsed < sampleInterval) {
+        return latest;
+    }
+    
+    float raw = calculateWaterLevel(frame);
+    
+    // Kayan medyan: tek karelik yansıma/gölge sıçramalarını bastırır
+    samples[sampleIndex] = raw;
+    sampleIndex = (sampleIndex + 1) % MEDIAN_WINDOW;
+    sampleCount = std::min(sampleCount + 1, MEDIAN_WINDOW);
+    std::array<float, MEDIAN_WINDOW> window = samples;
+    auto middle = window.begin() + sampleCount / 2;
+    std::nth_element(window.begin(), middle, window.begin() + sampleCount);
+    float median = *middle;
+    
+    if (!latest.valid) {
+        latest.currentLevel = median;
+        latest.riseRate = 0.0f;
+        latest.valid = true;
+    } else {
+        // Zaman sabitli EMA: örnekleme aralığından bağımsız yumuşatma
+        double dt = std::max(elapsed, 1e-3);
+        float alpha = levelSmoothing > 0 ? static_cast<float>(1.0 - std::exp(-dt / levelSmoothing)) : 1.0f;
+        float previous = latest.currentLevel;
+        latest.currentLevel += alpha * (median - latest.currentLevel);
+        
+        float instantRate = static_cast<float>((latest.currentLevel - previous) / dt * 60.0);
+        float beta = rateSmoothing > 0 ? static_cast<float>(1.0 - std::exp(-dt / rateSmoothing)) : 1.0f;
+        latest.riseRate += beta * (instantRate - latest.riseRate);
+    }
+    
+    // Medya zamanı duvar saatine bağlanır: canlı kaynakta gerçek zaman,
+    // dosyada kayıt hızında ilerleyen zaman
+    if (!hasWallOrigin) {
+        double now = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        wallOrigin = now - timestamp.count();
+        hasWallOrigin = true;
+    }
+    double wallTime = wallOrigin + timestamp.count();
+    history.append(wallTime, median);
+    
+    auto trend = history.trend(wallTime, trendWindow, warningThreshold, criticalThreshold);
+    latest.trendRate = trend.valid ? trend.rate : 0.0f;
+    latest.timeToWarning = trend.valid ? trend.timeToWarning : -1.0;
+    latest.timeToCritical = trend.valid ? trend.timeToCritical : -1.0;
+    
+    latest.rawLevel = raw;
+    latest.timestamp = timestamp;
+    latest.warningLevel = warningThreshold;
+    latest.criticalLevel = criticalThreshold;
+    latest.measurePoint = measurePointFor(latest.currentLevel);
+    
+    publishThresholdChange(latest.currentLevel);
+    return latest;
+}
+
+void WaterLevelDetector::publishThresholdChange(float level) {
+    // Histerezis: eşik çevresindeki salınım olay yağmuruna dönüşmez
+    int state = level >= criticalThreshold ? 2 : (level >= warningThreshold ? 1 : 0);
+    if (state < alarmState) {
+        float threshold = alarmState == 2 ? criticalThreshold : warningThreshold;
+        if (level > threshold - THRESHOLD_HYSTERESIS) state = alarmState;
+    }
+    if (state == alarmState) return;
+    
+    bool rising = state > alarmState;
+    int crossed = rising ? state : alarmState;
+    alarmState = state;
+    if (!eventBus) return;
+    
+    EventBus::Event event;
+    event.payload = EventBus::WaterLevelThreshold{
+        level, crossed == 2 ? criticalThreshold : warningThreshold, rising, crossed == 2};
+    event.priority = rising ? (state == 2 ? 5 : 4) : 2;
+    event.timestamp = latest.timestamp;
+    eventBus->publish(std::move(event));
 }
 
 WaterLevelDetector::WaterLevelInfo WaterLevelDetector::detectWaterLevel(const cv::Mat& frame) {
@@ -32,59 +161,86 @@ WaterLevelDetector::WaterLevelInfo WaterLevelDetector::detectWaterLevel(const cv
     
     // Su seviyesini hesapla
     info.currentLevel = calculateWaterLevel(frame);
+    info.rawLevel = info.currentLevel;
     info.warningLevel = warningThreshold;
     info.criticalLevel = criticalThreshold;
-    info.measurePoint = cv::Point(
-        bottomReference.x,
-        bottomReference.y - (bottomReference.y - topReference.y) * 
-        (info.currentLevel / 100.0f)
-    );
+    info.measurePoint = measurePointFor(info.currentLevel);
+    info.valid = true;
     
     return info;
 }
 
 float WaterLevelDetector::calculateWaterLevel(const cv::Mat& frame) {
-    cv::Mat roi;
-    cv::Rect validArea(topReference.x - 10, topReference.y,
-                      20, bottomReference.y - topReference.y);
-                      
-    // ROI sınırlarını kontrol et
-    validArea &= cv::Rect(0, 0, frame.cols, frame.rows);
-    if (validArea.width <= 0 || validArea.height <= 0) {
-        return 0.0f;
-    }
+    estimator.estimate(frame);
     
-    roi = frame(validArea);
-    
-    cv::Mat gray;
-    cv::cvtColor(roi, gray, cv::COLOR_BGR2GRAY);
+    latest.gaugeLevels.resize(estimator.gaugeCount());
+    for (size_t i = 0; i < estimator.gaugeCount(); i++) {
+        const auto& reading = estimator.reading(static_cast<int>(i));
+        latest.gaugeLevels[i] = reading.valid ? reading.level : -1.0f;
+    }
     
-    cv::Mat thresh;
-    cv::threshold(gray, thresh, 100, 255, cv::THRESH_BINARY);
+    // Su çizgisi seçilemediyse (düşük kontrast) son ham ölçüm korunur
+    const auto& reference = estimator.reading(0);
+    if (!reference.valid) {
+        return latest.rawLevel;
+    }
+    return std::min(100.0f, std::max(0.0f, reference.level));
+}
+
+cv::Rect WaterLevelDetector::tankArea(const cv::Size& size) {
+    const int width = size.width / 3;
+    const int height = static_cast<int>(size.height * 0.8);
+    return cv::Rect((size.width - width) / 2, (size.height - height) / 2, width, height);
+}
+
+void WaterLevelDetector::drawWaterScale(cv::Mat& canvas) const {
+    const cv::Rect tank = tankArea(canvas.size());
+    const int TANK_X = tank.x, TANK_Y = tank.y;
+    const int TANK_WIDTH = tank.width, TANK_HEIGHT = tank.height;
+    const cv::Scalar white(255, 255, 255, 255);  // 4. bileşen: BGRA tuvalde opak
     
-    int nonZero = cv::countNonZero(thresh);
-    float level = (float)nonZero / thresh.total() * 100.0f;
+    // Tank çerçevesi
+    cv::rectangle(canvas, 
+                 cv::Point(TANK_X, TANK_Y),
+                 cv::Point(TANK_X + TANK_WIDTH, TANK_Y + TANK_HEIGHT),
+                 white, 2);
+
+    // Seviye göstergesi
+    const int GAUGE_WIDTH = 30;
+    const int GAUGE_X = TANK_X + TANK_WIDTH + 20;
     
-    return std::min(100.0f, std::max(0.0f, level));
+    cv::rectangle(canvas,
+                 cv::Point(GAUGE_X, TANK_Y),
+                 cv::Point(GAUGE_X + GAUGE_WIDTH, TANK_Y + TANK_HEIGHT),
+                 white, 1);
+
+    // Seviye çizgileri
+    for (int i = 0; i <= 100; i += 25) {
+        int y = TANK_Y + TANK_HEIGHT - (i * TANK_HEIGHT / 100);
+        cv::line(canvas, 
+                 cv::Point(GAUGE_X - 5, y),
+                 cv::Point(GAUGE_X + GAUGE_WIDTH, y),
+                 white, 1);
+        
+        // Yüzde değerleri
+        cv::putText(canvas, std::to_string(i) + "%",
+                   cv::Point(GAUGE_X + GAUGE_WIDTH + 5, y + 5),
+                   cv::FONT_HERSHEY_SIMPLEX, 0.4,
+                   white, 1);
+    }
 }
 
-void WaterLevelDetector::drawLiveWaterLevel(cv::Mat& frame) {
+void WaterLevelDetector::drawLiveWaterLevel(cv::Mat& frame, bool drawScale) {
     static float time = 0;
     time += 0.1f;  // Dalga animasyonu için zaman güncelleme
 
-    WaterLevelInfo info = detectWaterLevel(frame);
+    // Ölçüm update() ile yapılır; çizim önbellekteki değeri kullanır
+    const WaterLevelInfo& info = latest;
     
     // Tank boyutları
-    const int TANK_WIDTH = frame.cols / 3;
-    const int TANK_HEIGHT = frame.rows * 0.8;
-    const int TANK_X = (frame.cols - TANK_WIDTH) / 2;
-    const int TANK_Y = (frame.rows - TANK_HEIGHT) / 2;
-    
-    // Tank çerçevesi
-    cv::rectangle(frame, 
-                 cv::Point(TANK_X, TANK_Y),
-                 cv::Point(TANK_X + TANK_WIDTH, TANK_Y + TANK_HEIGHT),
-                 cv::Scalar(255, 255, 255), 2);
+    const cv::Rect tank = tankArea(frame.size());
+    const int TANK_X = tank.x, TANK_Y = tank.y;
+    const int TANK_WIDTH = tank.width, TANK_HEIGHT = tank.height;
 
     // Su yüksekliği hesaplama
     int waterHeight = static_cast<int>(TANK_HEIGHT * (info.currentLevel / 100.0f));
@@ -129,31 +285,9 @@ void WaterLevelDetector::drawLiveWaterLevel(cv::Mat& frame) {
     }
     cv::polylines(frame, wavePoints2, false, cv::Scalar(255, 255, 255, 0.5), 2);
 
-    // Seviye göstergesi
+    // Mevcut seviye göstergesi
     const int GAUGE_WIDTH = 30;
     const int GAUGE_X = TANK_X + TANK_WIDTH + 20;
-    
-    cv::rectangle(frame,
-                 cv::Point(GAUGE_X, TANK_Y),
-                 cv::Point(GAUGE_X + GAUGE_WIDTH, TANK_Y + TANK_HEIGHT),
-                 cv::Scalar(255, 255, 255), 1);
-
-    // Seviye çizgileri
-    for (int i = 0; i <= 100; i += 25) {
-        int y = TANK_Y + TANK_HEIGHT - (i * TANK_HEIGHT / 100);
-        cv::line(frame, 
-                 cv::Point(GAUGE_X - 5, y),
-                 cv::Point(GAUGE_X + GAUGE_WIDTH, y),
-                 cv::Scalar(255, 255, 255), 1);
-        
-        // Yüzde değerleri
-        cv::putText(frame, std::to_string(i) + "%",
-                   cv::Point(GAUGE_X + GAUGE_WIDTH + 5, y + 5),
-                   cv::FONT_HERSHEY_SIMPLEX, 0.4,
-                   cv::Scalar(255, 255, 255), 1);
-    }
-
-    // Mevcut seviye göstergesi
     int currentY = TANK_Y + TANK_HEIGHT - (info.currentLevel * TANK_HEIGHT / 100);
     cv::rectangle(frame,
                  cv::Point(GAUGE_X, currentY),
@@ -167,6 +301,26 @@ void WaterLevelDetector::drawLiveWaterLevel(cv::Mat& frame) {
                 cv::Point(TANK_X + 10, TANK_Y + 30),
                 cv::FONT_HERSHEY_SIMPLEX, 1.0,
                 cv::Scalar(255, 255, 255), 2);
+    
+    // Yükselme hızı
+    std::stringstream rate;
+    rate << std::showpos << std::fixed << std::setprecision(1) << info.riseRate << " %/dk";
+    cv::putText(frame, rate.str(),
+                cv::Point(TANK_X + 10, TANK_Y + 60),
+                cv::FONT_HERSHEY_SIMPLEX, 0.6,
+                cv::Scalar(255, 255, 255), 1);
+
+    // Eğilime göre eşiğe kalan süre
+    double eta = info.currentLevel < info.warningLevel ? info.timeToWarning : info.timeToCritical;
+    if (eta > 0 && info.currentLevel < info.criticalLevel) {
+        std::stringstream remaining;
+        remaining << (info.currentLevel < info.warningLevel ? "Uyari" : "Kritik")
+                  << " ~" << static_cast<int>(std::ceil(eta / 60.0)) << " dk";
+        cv::putText(frame, remaining.str(),
+                    cv::Point(TANK_X + 10, TANK_Y + 85),
+                    cv::FONT_HERSHEY_SIMPLEX, 0.6,
+                    cv::Scalar(0, 255, 255), 1);
+    }
 
     // Uyarı mesajları
     if (info.currentLevel >= info.criticalLevel) {
@@ -182,6 +336,11 @@ void WaterLevelDetector::drawLiveWaterLevel(cv::Mat& frame) {
                    cv::Scalar(0, 255, 255), 2);
     }
 
+    // Sabit ölçek; katman kullanılıyorsa çağıran ayrıca karıştırır
+    if (drawScale) {
+        drawWaterScale(frame);
+    }
+
     // Dalga animasyonunu güncelle
     updateWaterAnimation();
 }
@@ -0,0 +1,271 @@
+#include "WaterLevelHistory.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+const WaterLevelHistory::RingHeader WaterLevelHistory::LAYOUT[RING_COUNT] = {
+    {21600, 1, 0},
+    {20160, 60, 0},
+    {17520, 3600, 0},
+};
+
+WaterLevelHistory::WaterLevelHistory()
+    : mapped(nullptr), mappedSize(0), fd(-1), header(nullptr), records{} {
+    memory.resize(storageSize());
+    attach(memory.data(), true);
+}
+
+WaterLevelHistory::~WaterLevelHistory() {
+    close();
+}
+
+size_t WaterLevelHistory::storageSize() {
+    size_t size = sizeof(FileHeader);
+    for (const auto& ring : LAYOUT) {
+        size += ring.capacity * sizeof(Sample);
+    }
+    return size;
+}
+
+void WaterLevelHistory::attach(char* base, bool initialize) {
+    header = reinterpret_cast<FileHeader*>(base);
+    if (initialize) {
+        std::memset(base, 0, storageSize());
+        header->magic = MAGIC;
+        header->version = VERSION;
+        header->ringCount = RING_COUNT;
+        std::copy(std::begin(LAYOUT), std::end(LAYOUT), header->rings);
+    }
+    
+    char* cursor = base + sizeof(FileHeader);
+    for (int i = 0; i < RING_COUNT; i++) {
+        records[i] = reinterpret_cast<Sample*>(cursor);
+        cursor += LAYOUT[i].capacity * sizeof(Sample);
+    }
+}
+
+bool WaterLevelHistory::open(const std::string& path) {
+    close();
+    
+    std::error_code error;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+    
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    
+    const size_t size = storageSize();
+    off_t existing = ::lseek(fd, 0, SEEK_END);
+    if (existing != static_cast<off_t>(size) && ::ftruncate(fd, size) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    
+    void* region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    mapped = region;
+    mappedSize = size;
+    
+    // Başlık düzenle uyuşmuyorsa (eski sürüm, farklı kapasite) yeniden başlat
+    const FileHeader* existingHeader = static_cast<const FileHeader*>(region);
+    bool compatible = existing == static_cast<off_t>(size) &&
+                      existingHeader->magic == MAGIC &&
+                      existingHeader->version == VERSION &&
+                      existingHeader->ringCount == RING_COUNT;
+    for (int i = 0; compatible && i < RING_COUNT; i++) {
+        compatible = existingHeader->rings[i].capacity == LAYOUT[i].capacity &&
+                     existingHeader->rings[i].resolution == LAYOUT[i].resolution;
+    }
+    attach(static_cast<char*>(region), !compatible);
+    if (compatible) {
+        dropFutureBuckets(std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+    
+    // Bellek içi tampon artık gereksiz
+    std::vector<char>().swap(memory);
+    return true;
+}
+
+void WaterLevelHistory::close() {
+    if (!mapped) return;
+    
+    ::msync(mapped, mappedSize, MS_ASYNC);
+    ::munmap(mapped, mappedSize);
+    ::close(fd);
+    mapped = nullptr;
+    mappedSize = 0;
+    fd = -1;
+    
+    memory.resize(storageSize());
+    attach(memory.data(), true);
+}
+
+const WaterLevelHistory::Sample& WaterLevelHistory::at(int ring, uint64_t sequence) const {
+    return records[ring][sequence % header->rings[ring].capacity];
+}
+
+void WaterLevelHistory::dropFutureBuckets(double now) {
+    // Önceki çalıştırma saatin ilerisine yazdıysa (ör. hızlı oynatma) bu kovalar
+    // sonraki tüm canlı örnekleri "sıra dışı" yapardı; kuyruk geri alınır
+    for (int i = 0; i < RING_COUNT; i++) {
+        RingHeader& ring = header->rings[i];
+        uint64_t first = ring.written - std::min<uint64_t>(ring.written, ring.capacity);
+        while (ring.written > first && at(i, ring.written - 1).time > now) {
+            ring.written--;
+        }
+    }
+}
+
+uint64_t WaterLevelHistory::lowerBound(int ring, double from) const {
+    const RingHeader& selected = header->rings[ring];
+    uint64_t low = selected.written - std::min<uint64_t>(selected.written, selected.capacity);
+    uint64_t high = selected.written;
+    
+    // Kovalar zamana göre sıralı: from'u içeren ya da sonraki ilk kova
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+        if (at(ring, middle).time + selected.resolution <= from) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+void WaterLevelHistory::append(double time, float level) {
+    if (!std::isfinite(time) || !std::isfinite(level)) return;
+    
+    for (int i = 0; i < RING_COUNT; i++) {
+        RingHeader& ring = header->rings[i];
+        int64_t bucket = static_cast<int64_t>(std::floor(time / ring.resolution)) * ring.resolution;
+        
+        if (ring.written > 0) {
+            Sample& last = records[i][(ring.written - 1) % ring.capacity];
+            if (bucket < last.time) return;  // Sıra dışı örnek
+            if (bucket == last.time) {
+                // Aynı kova: artımlı ortalama
+                last.count++;
+                last.mean += (level - last.mean) / last.count;
+                last.minimum = std::min(last.minimum, level);
+                last.maximum = std::max(last.maximum, level);
+                continue;
+            }
+        }
+        
+        // Kayıt önce yazılır, sayaç sonra ilerler (yarıda kalan yazım görünmez)
+        records[i][ring.written % ring.capacity] = {bucket, level, level, level, 1};
+        ring.written++;
+    }
+}
+
+size_t WaterLevelHistory::size(Resolution resolution) const {
+    const RingHeader& ring = header->rings[static_cast<int>(resolution)];
+    return static_cast<size_t>(std::min<uint64_t>(ring.written, ring.capacity));
+}
+
+WaterLevelHistory::Sample WaterLevelHistory::latest(Resolution resolution) const {
+    int index = static_cast<int>(resolution);
+    const RingHeader& ring = header->rings[index];
+    if (ring.written == 0) return Sample{0, 0, 0, 0, 0};
+    return at(index, ring.written - 1);
+}
+
+std::vector<WaterLevelHistory::Sample> WaterLevelHistory::query(Resolution resolution,
+                                                                double from, double to) const {
+    int index = static_cast<int>(resolution);
+    const RingHeader& ring = header->rings[index];
+    uint64_t low = lowerBound(index, from);
+    
+    std::vector<Sample> result;
+    for (uint64_t s = low; s < ring.written && at(index, s).time <= to; s++) {
+        result.push_back(at(index, s));
+    }
+    return result;
+}
+
+WaterLevelHistory::Trend WaterLevelHistory::trend(double now, double windowSeconds,
+                                                  float warning, float critical) const {
+    Trend result;
+    
+    // Kovalar zamanla seçilir: [now - pencere, now]. Kesinti ya da yeniden
+    // başlatma sonrası eski kovalar eğime karışmaz. Pencereyi tamamen kapsayan
+    // en ince halka; hiçbiri kapsamıyorsa en uzun süreyi kapsayan. Pencerenin
+    // MIN_TREND_COVERAGE kadarını kapsamayan ya da az kovalı halka aday değildir.
+    const double from = now - windowSeconds;
+    int ring = -1;
+    uint64_t first = 0, last = 0;   // Seçilen kovalar [first, last)
+    double bestCoverage = 0;
+    for (int i = 0; i < RING_COUNT; i++) {
+        const RingHeader& candidate = header->rings[i];
+        uint64_t begin = lowerBound(i, from);
+        uint64_t end = candidate.written;
+        while (end > begin && at(i, end - 1).time > now) end--;
+        if (end - begin < static_cast<uint64_t>(MIN_TREND_POINTS)) continue;
+        
+        double start = std::max<double>(at(i, begin).time, from);
+        double stop = std::min<double>(at(i, end - 1).time + candidate.resolution, now);
+        double coverage = stop - start;
+        if (coverage < windowSeconds * MIN_TREND_COVERAGE) continue;
+        if (coverage > bestCoverage) {
+            ring = i;
+            first = begin;
+            last = end;
+            bestCoverage = coverage;
+        }
+        if (coverage >= windowSeconds) break;
+    }
+    if (ring < 0) return result;
+    const RingHeader& selected = header->rings[ring];
+    
+    // Eşit aralıklı en çok MAX_TREND_POINTS kova (t gerçek zaman; boşluklar korunur)
+    double t[MAX_TREND_POINTS];
+    double y[MAX_TREND_POINTS];
+    uint64_t span = last - first;
+    int n = static_cast<int>(std::min<uint64_t>(span, MAX_TREND_POINTS));
+    for (int i = 0; i < n; i++) {
+        uint64_t offset = n > 1 ? (span - 1) * i / (n - 1) : 0;
+        const Sample& sample = at(ring, first + offset);
+        t[i] = sample.time + selected.resolution * 0.5 - now;  // Kova ortası, şimdiye göre
+        y[i] = sample.mean;
+    }
+    
+    // Theil-Sen: ikili eğimlerin medyanı
+    double slopes[MAX_TREND_POINTS * (MAX_TREND_POINTS - 1) / 2];
+    int slopeCount = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (t[j] != t[i]) slopes[slopeCount++] = (y[j] - y[i]) / (t[j] - t[i]);
+        }
+    }
+    if (slopeCount == 0) return result;
+    std::nth_element(slopes, slopes + slopeCount / 2, slopes + slopeCount);
+    double slope = slopes[slopeCount / 2];  // yüzde/saniye
+    
+    // Kesişim: y - eğim*t medyanı (t=0: şimdi)
+    double residuals[MAX_TREND_POINTS];
+    for (int i = 0; i < n; i++) residuals[i] = y[i] - slope * t[i];
+    std::nth_element(residuals, residuals + n / 2, residuals + n);
+    double level = residuals[n / 2];
+    
+    auto timeTo = [slope, level](float threshold) {
+        if (slope <= 0 || level >= threshold) return -1.0;
+        return (threshold - level) / slope;
+    };
+    
+    result.valid = true;
+    result.rate = static_cast<float>(slope * 60.0);
+    result.level = static_cast<float>(level);
+    result.timeToWarning = timeTo(warning);
+    result.timeToCritical = timeTo(critical);
+    result.points = n;
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "WaterlineEstimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+WaterlineEstimator::WaterlineEstimator()
+    : downscale(2), changeThreshold(2.0) {
+}
+
+int WaterlineEstimator::addGauge(const Gauge& gauge) {
+    State state;
+    state.gauge = gauge;
+    gauges.push_back(std::move(state));
+    return static_cast<int>(gauges.size()) - 1;
+}
+
+void WaterlineEstimator::setGauge(int index, const Gauge& gauge) {
+    if (index < 0 || index >= static_cast<int>(gauges.size())) return;
+    State state;
+    state.gauge = gauge;
+    gauges[index] = std::move(state);  // Eşlemeler bir sonraki ölçümde yeniden hazırlanır
+}
+
+void WaterlineEstimator::clearGauges() {
+    gauges.clear();
+}
+
+void WaterlineEstimator::setDownscale(int factor) {
+    downscale = std::max(1, factor);
+    for (auto& state : gauges) {
+        state.frameSize = cv::Size();
+    }
+}
+
+void WaterlineEstimator::setChangeThreshold(double meanAbsDiff) {
+    changeThreshold = std::max(0.0, meanAbsDiff);
+}
+
+void WaterlineEstimator::prepare(State& state, const cv::Size& frameSize) const {
+    state.frameSize = frameSize;
+    state.previousGray.release();
+    state.reading = Reading();
+    
+    const Gauge& g = state.gauge;
+    float half = std::max(1.0f, g.bandWidth * 0.5f);
+    cv::Rect bounds(cv::Point(static_cast<int>(std::floor(std::min(g.top.x, g.bottom.x) - half)),
+                              static_cast<int>(std::floor(std::min(g.top.y, g.bottom.y) - half))),
+                    cv::Point(static_cast<int>(std::ceil(std::max(g.top.x, g.bottom.x) + half)) + 1,
+                              static_cast<int>(std::ceil(std::max(g.top.y, g.bottom.y) + half)) + 1));
+    state.roi = bounds & cv::Rect(0, 0, frameSize.width, frameSize.height);
+    if (state.roi.width <= 0 || state.roi.height <= 0) {
+        state.roi = cv::Rect();
+        return;
+    }
+    
+    // Küçük bölge koordinatlarında parça ve dik yön
+    float scale = 1.0f / downscale;
+    cv::Point2f origin(static_cast<float>(state.roi.x), static_cast<float>(state.roi.y));
+    cv::Point2f top = (g.top - origin) * scale;
+    cv::Point2f bottom = (g.bottom - origin) * scale;
+    cv::Point2f axis = bottom - top;
+    float length = std::sqrt(axis.x * axis.x + axis.y * axis.y);
+    
+    int count = std::max(MIN_SAMPLES, static_cast<int>(std::ceil(length)));
+    int band = std::max(1, static_cast<int>(std::round(g.bandWidth * scale)));
+    cv::Point2f normal = length > 0 ? cv::Point2f(-axis.y / length, axis.x / length)
+                                    : cv::Point2f(1, 0);
+    
+    // Satır i: üstten alta i. örnek; sütun j: bant içindeki dik ofset
+    state.mapX.create(count, band, CV_32FC1);
+    state.mapY.create(count, band, CV_32FC1);
+    for (int i = 0; i < count; i++) {
+        cv::Point2f center = top + axis * (count > 1 ? static_cast<float>(i) / (count - 1) : 0.0f);
+        float* xs = state.mapX.ptr<float>(i);
+        float* ys = state.mapY.ptr<float>(i);
+        for (int j = 0; j < band; j++) {
+            float offset = j - (band - 1) * 0.5f;
+            xs[j] = center.x + normal.x * offset;
+            ys[j] = center.y + normal.y * offset;
+        }
+    }
+}
+
+bool WaterlineEstimator::fitStep(const float* profile, int count, std::vector<double>& prefix,
+                                 int& split, float& contrast) {
+    // prefix[k] = ilk k örneğin toplamı
+    prefix.resize(count + 1);
+    prefix[0] = 0.0;
+    for (int i = 0; i < count; i++) {
+        prefix[i + 1] = prefix[i] + profile[i];
+    }
+    
+    // İki seviyeli basamak uydurma: SSE'yi en küçükleyen bölme, sınıflar arası
+    // k(n-k)(m1-m2)^2 terimini en büyükleyen bölmedir
+    double total = prefix[count];
+    double bestScore = -1.0;
+    int best = -1;
+    for (int k = 1; k < count; k++) {
+        double upper = prefix[k] / k;
+        double lower = (total - prefix[k]) / (count - k);
+        double diff = upper - lower;
+        double score = static_cast<double>(k) * (count - k) * diff * diff;
+        if (score > bestScore) {
+            bestScore = score;
+            best = k;
+            contrast = static_cast<float>(std::abs(diff));
+        }
+    }
+    split = best;
+    return best > 0;
+}
+
+void WaterlineEstimator::estimateGauge(State& state, const cv::Mat& frame) const {
+    state.reading.recomputed = false;
+    if (state.frameSize != frame.size()) {
+        prepare(state, frame.size());
+    }
+    if (state.roi.area() == 0) {
+        state.reading.valid = false;
+        return;
+    }
+    
+    // Bölgeyi küçült (INTER_AREA alan ortalaması parlama beneklerini de yumuşatır)
+    cv::Size smallSize(std::max(1, state.roi.width / downscale),
+                       std::max(1, state.roi.height / downscale));
+    cv::resize(frame(state.roi), state.small, smallSize, 0, 0, cv::INTER_AREA);
+    if (state.small.channels() == 3) {
+        cv::cvtColor(state.small, state.gray, cv::COLOR_BGR2GRAY);
+    } else {
+        state.small.copyTo(state.gray);
+    }
+    
+    // Bölge değişmediyse önceki sonuç geçerli
+    if (state.reading.valid && !state.previousGray.empty() &&
+        cv::norm(state.gray, state.previousGray, cv::NORM_L1) / state.gray.total() < changeThreshold) {
+        return;
+    }
+    std::swap(state.gray, state.previousGray);
+    
+    // Parça boyunca örnekleme ve bant ortalaması
+    cv::remap(state.previousGray, state.samples, state.mapX, state.mapY,
+              cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+    cv::reduce(state.samples, state.profile, 1, cv::REDUCE_AVG, CV_32F);
+    
+    int count = state.profile.rows;
+    int split;
+    float contrast = 0;
+    state.reading.recomputed = true;
+    if (!fitStep(state.profile.ptr<float>(0), count, state.prefix, split, contrast) ||
+        contrast < MIN_CONTRAST) {
+        state.reading.valid = false;
+        state.reading.contrast = contrast;
+        return;
+    }
+    
+    // split: su çizgisinin üstünde kalan örnek sayısı
+    float fraction = static_cast<float>(split) / count;
+    const Gauge& g = state.gauge;
+    state.reading.level = (1.0f - fraction) * 100.0f;
+    state.reading.contrast = contrast;
+    state.reading.waterline = g.top + (g.bottom - g.top) * fraction;
+    state.reading.valid = true;
+}
+
+void WaterlineEstimator::estimate(const cv::Mat& frame) {
+    if (frame.empty() || gauges.empty()) return;
+    
+    cv::parallel_for_(cv::Range(0, static_cast<int>(gauges.size())),
+                      [this, &frame](const cv::Range& range) {
+        for (int i = range.start; i < range.end; i++) {
+            estimateGauge(gauges[i], frame);
+        }
+    });
+}
\ No newline at end of file
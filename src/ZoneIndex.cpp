@@ -0,0 +1,292 @@
+#include "ZoneIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+const int MIN_CELL_SIZE = 16;
+const int GRID_DIM = 32;  // Uzun kenar boyunca hedef hücre sayısı
+}
+
+ZoneIndex::ZoneIndex()
+    : cellSize(MIN_CELL_SIZE), gridCols(0), gridRows(0) {
+}
+
+int ZoneIndex::addZone(const std::vector<cv::Point>& polygon, const std::string& name) {
+    if (polygon.size() < 3) return -1;
+
+    Zone zone;
+    zone.name = name.empty() ? "Zone " + std::to_string(zones.size() + 1) : name;
+    zone.bounds = cv::boundingRect(polygon);
+    zone.vertexStart = static_cast<int>(xs.size());
+    zone.vertexCount = static_cast<int>(polygon.size());
+    for (const auto& p : polygon) {
+        xs.push_back(static_cast<float>(p.x));
+        ys.push_back(static_cast<float>(p.y));
+    }
+    zones.push_back(zone);
+
+    // Bölgeler nadiren eklenir; ızgara her eklemede yeniden kurulur
+    rebuildGrid();
+    return static_cast<int>(zones.size()) - 1;
+}
+
+void ZoneIndex::clear() {
+    zones.clear();
+    xs.clear();
+    ys.clear();
+    cellStart.clear();
+    cellZones.clear();
+    gridCols = gridRows = 0;
+}
+
+std::vector<cv::Point> ZoneIndex::polygon(int index) const {
+    const Zone& z = zones[index];
+    std::vector<cv::Point> points;
+    points.reserve(z.vertexCount);
+    for (int k = 0; k < z.vertexCount; k++) {
+        points.emplace_back(static_cast<int>(xs[z.vertexStart + k]),
+                            static_cast<int>(ys[z.vertexStart + k]));
+    }
+    return points;
+}
+
+void ZoneIndex::rebuildGrid() {
+    gridBounds = zones[0].bounds;
+    for (const auto& z : zones) gridBounds |= z.bounds;
+
+    cellSize = std::max(MIN_CELL_SIZE,
+                        std::max(gridBounds.width, gridBounds.height) / GRID_DIM + 1);
+    gridCols = gridBounds.width / cellSize + 1;
+    gridRows = gridBounds.height / cellSize + 1;
+
+    // Sayma sıralaması ile CSR: her bölge kutusunun kapsadığı tüm hücrelere girer
+    auto forEachCell = [this](const cv::Rect& box, auto&& fn) {
+        int x0 = (box.x - gridBounds.x) / cellSize;
+        int y0 = (box.y - gridBounds.y) / cellSize;
+        int x1 = std::min(gridCols - 1, (box.x + box.width - gridBounds.x) / cellSize);
+        int y1 = std::min(gridRows - 1, (box.y + box.height - gridBounds.y) / cellSize);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) fn(cy * gridCols + cx);
+        }
+    };
+
+    cellStart.assign(gridCols * gridRows + 1, 0);
+    for (const auto& z : zones) {
+        forEachCell(z.bounds, [this](int cell) { cellStart[cell + 1]++; });
+    }
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
+
+    cellZones.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < static_cast<int>(zones.size()); i++) {
+        forEachCell(zones[i].bounds, [&](int cell) { cellZones[fill[cell]++] = i; });
+    }
+}
+
+int ZoneIndex::cellOf(const cv::Point2f& point) const {
+    if (gridCols == 0) return -1;
+    float dx = point.x - gridBounds.x;
+    float dy = point.y - gridBounds.y;
+    if (dx < 0 || dy < 0 || dx >= gridBounds.width || dy >= gridBounds.height) return -1;
+    int cx = std::min(gridCols - 1, static_cast<int>(dx) / cellSize);
+    int cy = std::min(gridRows - 1, static_cast<int>(dy) / cellSize);
+    return cy * gridCols + cx;
+}
+
+void ZoneIndex::testZone(const Zone& zone, const float* px, const float* py,
+                         int count, unsigned char* inside) const {
+    std::fill(inside, inside + count, 0);
+
+    const float* vx = xs.data() + zone.vertexStart;
+    const float* vy = ys.data() + zone.vertexStart;
+    const int n = zone.vertexCount;
+
+    // Kenar dışta, noktalar içte: iç döngü dallanmasız ve vektörleşebilir
+    for (int a = 0, b = n - 1; a < n; b = a++) {
+        const float xa = vx[a], ya = vy[a];
+        const float xb = vx[b], yb = vy[b];
+        if (ya == yb) continue;  // Yatay kenar ışını kesmez
+        const float slope = (xb - xa) / (yb - ya);
+
+        for (int j = 0; j < count; j++) {
+            const bool straddles = (ya > py[j]) != (yb > py[j]);
+            const float crossX = xa + (py[j] - ya) * slope;
+            inside[j] ^= static_cast<unsigned char>(straddles & (px[j] < crossX));
+        }
+    }
+}
+
+void ZoneIndex::containsBatch(const std::vector<cv::Point2f>& points,
+                              std::vector<Hit>& hits) const {
+    hits.clear();
+    if (zones.empty() || points.empty()) return;
+
+    // 1) Izgara + sınır kutusu ile aday (nokta, bölge) çiftleri
+    std::vector<Hit> candidates;
+    std::vector<int> zoneStart(zones.size() + 1, 0);
+    for (int i = 0; i < static_cast<int>(points.size()); i++) {
+        const cv::Point2f& p = points[i];
+        int cell = cellOf(p);
+        if (cell < 0) continue;
+        for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+            int z = cellZones[k];
+            const cv::Rect& b = zones[z].bounds;
+            if (p.x >= b.x && p.y >= b.y && p.x < b.x + b.width && p.y < b.y + b.height) {
+                candidates.push_back({i, z});
+                zoneStart[z + 1]++;
+            }
+        }
+    }
+    if (candidates.empty()) return;
+
+    // 2) Adayları bölgeye göre grupla ve koordinatları bitişik dizilere topla
+    std::partial_sum(zoneStart.begin(), zoneStart.end(), zoneStart.begin());
+    std::vector<int> grouped(candidates.size());
+    std::vector<int> fill(zoneStart.begin(), zoneStart.end() - 1);
+    for (const auto& c : candidates) grouped[fill[c.zone]++] = c.point;
+
+    std::vector<float> px(grouped.size()), py(grouped.size());
+    for (size_t k = 0; k < grouped.size(); k++) {
+        px[k] = points[grouped[k]].x;
+        py[k] = points[grouped[k]].y;
+    }
+    std::vector<unsigned char> inside(grouped.size());
+
+    // 3) Bölge başına toplu çokgen testi
+    for (int z = 0; z < static_cast<int>(zones.size()); z++) {
+        int begin = zoneStart[z];
+        int count = zoneStart[z + 1] - begin;
+        if (count == 0) continue;
+        testZone(zones[z], px.data() + begin, py.data() + begin, count, inside.data() + begin);
+        for (int k = begin; k < begin + count; k++) {
+            if (inside[k]) hits.push_back({grouped[k], z});
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+        return a.point != b.point ? a.point < b.point : a.zone < b.zone;
+    });
+}
+
+bool ZoneIndex::contains(const cv::Point2f& point) const {
+    int cell = cellOf(point);
+    if (cell < 0) return false;
+
+    for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+        const Zone& z = zones[cellZones[k]];
+        if (!z.bounds.contains(cv::Point(static_cast<int>(std::floor(point.x)),
+                                         static_cast<int>(std::floor(point.y))))) {
+            continue;
+        }
+        unsigned char inside = 0;
+        testZone(z, &point.x, &point.y, 1, &inside);
+        if (inside) return true;
+    }
+    return false;
+}
+
+void ZoneIndex::crossZone(const Zone& zone, const float* ax, const float* ay,
+                          const float* bx, const float* by, int count, float* firstT) const {
+    std::fill(firstT, firstT + count, std::numeric_limits<float>::infinity());
+
+    const float* vx = xs.data() + zone.vertexStart;
+    const float* vy = ys.data() + zone.vertexStart;
+    const int n = zone.vertexCount;
+
+    // Yönelim testleri: parça uçları kenarın zıt taraflarında ve kenar uçları
+    // parçanın zıt taraflarındaysa kesişirler. t = d1 / (d1 - d2)
+    for (int e = 0, f = n - 1; e < n; f = e++) {
+        const float qx = vx[f], qy = vy[f];
+        const float ex = vx[e] - qx, ey = vy[e] - qy;
+
+        for (int j = 0; j < count; j++) {
+            const float sx = bx[j] - ax[j], sy = by[j] - ay[j];
+            const float d1 = ex * (ay[j] - qy) - ey * (ax[j] - qx);
+            const float d2 = ex * (by[j] - qy) - ey * (bx[j] - qx);
+            const float d3 = sx * (qy - ay[j]) - sy * (qx - ax[j]);
+            const float d4 = sx * (vy[e] - ay[j]) - sy * (vx[e] - ax[j]);
+            const bool crosses = (d1 * d2 <= 0.0f) & (d3 * d4 <= 0.0f) & (d1 != d2);
+            const float t = crosses ? d1 / (d1 - d2) : std::numeric_limits<float>::infinity();
+            firstT[j] = std::min(firstT[j], t);
+        }
+    }
+}
+
+void ZoneIndex::intersectsBatch(const std::vector<cv::Point2f>& starts,
+                                const std::vector<cv::Point2f>& ends,
+                                std::vector<SegmentHit>& hits) const {
+    hits.clear();
+    if (zones.empty() || starts.empty()) return;
+
+    // 1) Parça sınır kutusunun kapsadığı hücrelerden aday bölgeler
+    std::vector<Hit> candidates;
+    std::vector<int> zoneStart(zones.size() + 1, 0);
+    std::vector<int> lastSegment(zones.size(), -1);  // Hücreler arası tekrarı önler
+    for (int i = 0; i < static_cast<int>(starts.size()); i++) {
+        const float minX = std::min(starts[i].x, ends[i].x) - gridBounds.x;
+        const float minY = std::min(starts[i].y, ends[i].y) - gridBounds.y;
+        const float maxX = std::max(starts[i].x, ends[i].x) - gridBounds.x;
+        const float maxY = std::max(starts[i].y, ends[i].y) - gridBounds.y;
+        if (maxX < 0 || maxY < 0 || minX >= gridBounds.width || minY >= gridBounds.height) {
+            continue;
+        }
+
+        int x0 = std::max(0, static_cast<int>(minX) / cellSize);
+        int y0 = std::max(0, static_cast<int>(minY) / cellSize);
+        int x1 = std::min(gridCols - 1, static_cast<int>(maxX) / cellSize);
+        int y1 = std::min(gridRows - 1, static_cast<int>(maxY) / cellSize);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int cell = cy * gridCols + cx;
+                for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                    int z = cellZones[k];
+                    if (lastSegment[z] == i) continue;
+                    lastSegment[z] = i;
+
+                    const cv::Rect& b = zones[z].bounds;
+                    if (maxX + gridBounds.x < b.x || maxY + gridBounds.y < b.y ||
+                        minX + gridBounds.x >= b.x + b.width ||
+                        minY + gridBounds.y >= b.y + b.height) {
+                        continue;
+                    }
+                    candidates.push_back({i, z});
+                    zoneStart[z + 1]++;
+                }
+            }
+        }
+    }
+    if (candidates.empty()) return;
+
+    // 2) Bölgeye göre grupla, uç noktaları bitişik dizilere topla
+    std::partial_sum(zoneStart.begin(), zoneStart.end(), zoneStart.begin());
+    std::vector<int> grouped(candidates.size());
+    std::vector<int> fill(zoneStart.begin(), zoneStart.end() - 1);
+    for (const auto& c : candidates) grouped[fill[c.zone]++] = c.point;
+
+    const size_t total = grouped.size();
+    std::vector<float> ax(total), ay(total), bx(total), by(total), firstT(total);
+    for (size_t k = 0; k < total; k++) {
+        ax[k] = starts[grouped[k]].x;
+        ay[k] = starts[grouped[k]].y;
+        bx[k] = ends[grouped[k]].x;
+        by[k] = ends[grouped[k]].y;
+    }
+
+    // 3) Bölge başına toplu kesişim testi
+    for (int z = 0; z < static_cast<int>(zones.size()); z++) {
+        int begin = zoneStart[z];
+        int count = zoneStart[z + 1] - begin;
+        if (count == 0) continue;
+        crossZone(zones[z], ax.data() + begin, ay.data() + begin,
+                  bx.data() + begin, by.data() + begin, count, firstT.data() + begin);
+        for (int k = begin; k < begin + count; k++) {
+            if (firstT[k] <= 1.0f) hits.push_back({grouped[k], z, firstT[k]});
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const SegmentHit& a, const SegmentHit& b) {
+        return a.segment != b.segment ? a.segment < b.segment : a.zone < b.zone;
+    });
+}
\ No newline at end of file
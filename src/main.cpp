@@ -2,6 +2,10 @@
 #include "VideoUtils.hpp"
 #include "MenuSystem.hpp"
 #include "WaterLevelDetector.hpp"
+#include "OverlayCompositor.hpp"
+#include "AsyncRecorder.hpp"
+#include <csignal>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <limits>
@@ -119,13 +123,22 @@ FastyDetector::InputSettings getInitialSettings() {
     return settings;
 }
 
-int main() {
+int main(int argc, char** argv) {
     try {
         // Başlangıç ekranı
         showSplashScreen();
         
         // Başlangıç ayarlarını al
         auto settings = getInitialSettings();
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--headless") == 0) {
+                settings.headless = true;
+            }
+        }
+        if (settings.headless) {
+            // Pencere/klavye yok; Ctrl+C ile sonlandırılır
+            std::signal(SIGINT, [](int) { isRunning = false; });
+        }
         
         // Detector'ı yapılandır ve başlat
         FastyDetector detector;
@@ -144,6 +157,12 @@ int main() {
             cv::Point(50, 500)     // Alt referans
         );
         waterDetector.setThresholds(70.0f, 90.0f);  // Uyarı ve kritik seviyeler
+        waterDetector.setEventBus(detector.getEventBus());  // Eşik geçişleri bildirime gider
+        // Kalıcı geçmiş yalnızca canlı kaynakta; video dosyası bellekte kalır
+        if (settings.sourceType == FastyDetector::InputSettings::SourceType::CAMERA &&
+            !waterDetector.enableHistory("history/water_level.bin")) {
+            std::cerr << "Su seviyesi geçmişi açılamadı; yalnızca bellekte tutulacak" << std::endl;
+        }
 
         // Capture referansını al
         cv::VideoCapture& capture = detector.getCapture();
@@ -151,6 +170,12 @@ int main() {
         // Menü sistemini başlat
         MenuSystem menu(detector);
         
+        // Sabit ekran katmanları (alttan üste)
+        OverlayCompositor overlays;
+        overlays.setHeadless(settings.headless);
+        const int scaleLayer = overlays.addLayer("waterScale");
+        const int menuLayer = overlays.addLayer("menu");
+        
         // Video kaydedici ayarları
         VideoUtils::RecordingConfig recordConfig;
         recordConfig.width = settings.width;
@@ -158,9 +183,13 @@ int main() {
         recordConfig.fps = settings.sourceType == FastyDetector::InputSettings::SourceType::CAMERA ? 
                           30.0 : capture.get(cv::CAP_PROP_FPS);
         recordConfig.isColor = true;
+        recordConfig.codec = VideoUtils::Codec::MJPG;  // Düşük CPU; boyut için XVID/H264
+        recordConfig.segmentSeconds = 300.0;           // 5 dk'lık segmentler + .idx yan dosyası
+        recordConfig.idleFps = 1.0;                    // Hareket yokken 1 FPS arşiv
+        recordConfig.activityHold = 10.0;              // Son hareketten 10 sn sonra yavaşla
         
-        cv::VideoWriter videoWriter;
-        cv::Mat frame, prevFrame;
+        AsyncRecorder recorder(16, AsyncRecorder::DropPolicy::DROP_OLDEST);
+        cv::Mat frame, display;  // display: üzerine çizim yapılan kopya
         
         // Ana işlem döngüsü
         while (isRunning) {
@@ -179,76 +208,97 @@ int main() {
                         throw std::runtime_error("Frame alınamadı!");
                     }
 
-                    // Su seviyesi görselleştirmesi
-                    waterDetector.drawLiveWaterLevel(frame);
+                    // Su seviyesi: kare başına en çok bir ölçüm, sonuç önbellekte
+                    const auto& waterInfo = waterDetector.update(frame, detector.getFrameTimestamp());
 
-                    // Nesne tespiti
+                    // Nesne tespiti (her zaman temiz kare üzerinde)
                     auto detections = detector.detect(frame);
                     
-                    // Su üzerindeki nesneler için özel kontroller ve uyarılar
-                    for (auto& det : detections) {
-                        // Nesnenin su seviyesine göre konumu
-                        auto waterInfo = waterDetector.detectWaterLevel(frame);
-                        if (det.center.y > waterInfo.measurePoint.y) {
-                            // Su altındaki nesne uyarısı
-                            std::string warningText = det.className + " su altında!";
-                            cv::putText(frame, warningText,
-                                      cv::Point(10, 60 + (det.trackId * 30)),
-                                      cv::FONT_HERSHEY_SIMPLEX, 0.8,
-                                      cv::Scalar(0, 0, 255), 2);
-                        }
+                    if (!overlays.isHeadless()) {
+                        // Çizimler ayrı tamponda: kare, uyarı görüntüleri için temiz kalır
+                        VideoUtils::detachIfShared(display);
+                        frame.copyTo(display);
                         
-                        // Nesne takibi ve yörünge çizimi
-                        if (det.trajectory.size() > 1) {
-                            for (size_t i = 1; i < det.trajectory.size(); i++) {
-                                cv::line(frame, det.trajectory[i-1], det.trajectory[i],
-                                       cv::Scalar(0, 255, 0), 2);
+                        // Dinamik kısım (dalga, seviye) her kare; ölçek katmandan. Katman
+                        // tespit çizimlerinden önce karıştırılır (kutular ölçeğin üstünde)
+                        waterDetector.drawLiveWaterLevel(display, false);
+                        overlays.updateLayer(scaleLayer, OverlayCompositor::sizeKey(display.size()),
+                                             display.size(),
+                                             [&](cv::Mat& canvas) { waterDetector.drawWaterScale(canvas); });
+                        overlays.compose(scaleLayer, display);
+                    
+                        // Su üzerindeki nesneler için özel kontroller ve uyarılar
+                        int warningRow = 0;
+                        for (auto& det : detections) {
+                            // Nesnenin su seviyesine göre konumu
+                            if (det.center.y > waterInfo.measurePoint.y) {
+                                // Su altındaki nesne uyarısı (her uyarı bir satır)
+                                std::string warningText = det.className + " su altında!";
+                                cv::putText(display, warningText,
+                                          cv::Point(10, 60 + (warningRow++ * 30)),
+                                          cv::FONT_HERSHEY_SIMPLEX, 0.8,
+                                          cv::Scalar(0, 0, 255), 2);
                             }
                         }
-                    }
-                    
-                    // Tespitleri çiz
-                    detector.drawDetections(frame, detections);
-                    
-                    // Grid çizimi
-                    if (settings.showGrid) {
-                        VideoUtils::drawGrid(frame);
-                    }
-                    
-                    // FPS ve bilgi çizimi
-                    if (settings.showFPS) {
-                        VideoUtils::drawFPS(frame, detector.getCurrentFPS());
-                    }
-                    
-                    // Video ilerleme çubuğu
-                    if (settings.sourceType == FastyDetector::InputSettings::SourceType::VIDEO_FILE) {
-                        VideoUtils::VideoInfo info;
-                        info.width = capture.get(cv::CAP_PROP_FRAME_WIDTH);
-                        info.height = capture.get(cv::CAP_PROP_FRAME_HEIGHT);
-                        info.fps = capture.get(cv::CAP_PROP_FPS);
-                        info.totalFrames = capture.get(cv::CAP_PROP_FRAME_COUNT);
-                        info.currentFrame = capture.get(cv::CAP_PROP_POS_FRAMES);
-                        info.duration = info.totalFrames / info.fps;
-                        info.isCamera = false;
                         
-                        VideoUtils::drawProgress(frame, info);
-                    }
-                    
-                    // Menü çizimi
-                    if (menu.isMenuVisible()) {
-                        menu.draw(frame);
+                        // İz yörüngeleri ve tespitleri çiz
+                        detector.drawTrajectories(display);
+                        detector.drawDetections(display, detections);
+                        
+                        // Grid doğrudan çizilir: birkaç düz çizgi, katman karıştırmadan ucuz
+                        if (detector.getInputSettings().showGrid) {
+                            VideoUtils::drawGrid(display);
+                        }
+                        
+                        // FPS ve bilgi çizimi
+                        if (detector.getInputSettings().showFPS) {
+                            VideoUtils::drawFPS(display, detector.getCurrentFPS());
+                        }
+                        
+                        // Video ilerleme çubuğu
+                        if (settings.sourceType == FastyDetector::InputSettings::SourceType::VIDEO_FILE) {
+                            VideoUtils::VideoInfo info;
+                            info.width = capture.get(cv::CAP_PROP_FRAME_WIDTH);
+                            info.height = capture.get(cv::CAP_PROP_FRAME_HEIGHT);
+                            info.fps = capture.get(cv::CAP_PROP_FPS);
+                            info.totalFrames = capture.get(cv::CAP_PROP_FRAME_COUNT);
+                            info.currentFrame = capture.get(cv::CAP_PROP_POS_FRAMES);
+                            info.duration = info.totalFrames / info.fps;
+                            info.isCamera = false;
+                            
+                            VideoUtils::drawProgress(display, info);
+                        }
+                        
+                        // Menü: içerik değiştiğinde yeniden rasterleştirilir
+                        overlays.setVisible(menuLayer, menu.isMenuVisible());
+                        if (menu.isMenuVisible()) {
+                            overlays.updateLayer(menuLayer,
+                                                 OverlayCompositor::sizeKey(display.size(), menu.getRevision()),
+                                                 display.size(),
+                                                 [&menu](cv::Mat& canvas) { menu.renderLayer(canvas); });
+                        }
+                        
+                        overlays.compose(menuLayer, display);
                     }
                     
-                    // Video kaydı
-                    if (isRecording && videoWriter.isOpened()) {
-                        videoWriter.write(frame);
+                    // Video kaydı (kodlama ayrı iş parçacığında; tampon her kare yenilenir)
+                    if (isRecording) {
+                        recorder.submit(overlays.isHeadless() ? frame : display,
+                                        detector.getFrameTimestamp(), detector.getTrackedObjects());
+                        if (!recorder.isRecording()) {
+                            recorder.stop();
+                            isRecording = false;
+                            std::cerr << "Kayıt durdu: yeni segment açılamadı" << std::endl;
+                        }
                     }
-                    
-                    prevFrame = frame.clone();
+                }
+                
+                if (overlays.isHeadless()) {
+                    continue;
                 }
                 
                 // Görüntüyü göster
-                cv::imshow("Fasty AI Detection", frame);
+                cv::imshow("Fasty AI Detection", display);
                 
                 // Tuş kontrolü
                 int key = cv::waitKey(1);
@@ -281,22 +331,29 @@ int main() {
                                     
                                 case 's':  // Ekran görüntüsü
                                 case 'S':
-                                    {
-                                        std::string filename = VideoUtils::generateFilename("screenshot") + ".jpg";
-                                        VideoUtils::saveFrame(frame, filename);
+                                    // Kodlama arka planda; arayüz beklemez
+                                    if (detector.saveSnapshot(display, "screenshot").empty()) {
+                                        std::cerr << "Ekran görüntüsü kuyruğu dolu" << std::endl;
                                     }
                                     break;
                                     
                                 case 'r':  // Kayıt başlat/durdur
                                 case 'R':
                                     if (!isRecording) {
-                                        std::string filename = VideoUtils::generateFilename("video") + ".avi";
-                                        recordConfig.filename = filename;
-                                        videoWriter = VideoUtils::createVideoWriter(recordConfig);
-                                        isRecording = true;
+                                        recordConfig.filename = VideoUtils::generateFilename("video") +
+                                                                VideoUtils::codecExtension(recordConfig.codec);
+                                        isRecording = recorder.start(recordConfig);
+                                        if (!isRecording) {
+                                            std::cerr << "Kayıt başlatılamadı: " << recordConfig.filename << std::endl;
+                                        }
                                     } else {
-                                        videoWriter.release();
+                                        recorder.stop();
+                                        auto stats = recorder.getStats();
                                         isRecording = false;
+                                        std::cout << "Kayıt: " << stats.written << " kare yazıldı, "
+                                                  << stats.dropped << " kare düştü, "
+                                                  << stats.skipped << " sakin kare atlandı, "
+                                                  << stats.segments << " segment" << std::endl;
                                     }
                                     break;
                             }
@@ -312,9 +369,7 @@ int main() {
         
         // Temizlik
         detector.stop();
-        if (videoWriter.isOpened()) {
-            videoWriter.release();
-        }
+        recorder.stop();
         cv::destroyAllWindows();
         
     }